@@ -1,10 +1,198 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include <cstring>
 
+#include <omp.h>
+
+#include "flat_string_vector.h"
+#include "simd.h"
+
 namespace copy {
 
+    // size in bytes of the last level cache as reported by sysfs, 0 if it can't be read
+    inline auto llc_size() -> std::size_t {
+        static const std::size_t llc = [] {
+            std::size_t best_level = 0, best_size = 0;
+            for (std::size_t idx = 0;; ++idx) {
+                const auto dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(idx) + "/";
+                std::ifstream level_file(dir + "level"), type_file(dir + "type"), size_file(dir + "size");
+                if (!level_file || !size_file) {
+                    break;
+                }
+
+                std::size_t level = 0, size = 0;
+                std::string type;
+                char unit = 0;
+                level_file >> level;
+                type_file >> type;
+                size_file >> size >> unit;
+                if (type == "Instruction") {
+                    continue;
+                }
+                switch (unit) {
+                    case 'K':
+                        size <<= 10;
+                        break;
+                    case 'M':
+                        size <<= 20;
+                        break;
+                    case 'G':
+                        size <<= 30;
+                        break;
+                    default:
+                        break;
+                }
+                if (level >= best_level) {
+                    best_level = level;
+                    best_size = size;
+                }
+            }
+            return best_size;
+        }();
+        return llc;
+    }
+
+    namespace detail {
+
+        // a copy this large would evict most of the LLC, so loop_alg streams it past the caches instead
+        inline constexpr double STREAMING_LLC_FRACTION = 0.5;
+
+        inline auto threshold_for(double llc_fraction) -> std::size_t {
+            const auto llc = llc_size();
+            return llc == 0 ? std::numeric_limits<std::size_t>::max() : static_cast<std::size_t>(llc_fraction * llc);
+        }
+
+        inline auto streaming_threshold_ref() -> std::atomic<std::size_t> & {
+            static std::atomic<std::size_t> threshold{threshold_for(STREAMING_LLC_FRACTION)};
+            return threshold;
+        }
+
+        inline constexpr std::size_t CACHE_LINE = 64;
+
+        // bytes to copy with regular stores until dst is cache line aligned
+        inline auto head_bytes(const std::byte *dst, std::size_t bytes) -> std::size_t {
+            const auto misalignment = reinterpret_cast<std::uintptr_t>(dst) % CACHE_LINE;
+            return std::min(bytes, misalignment == 0 ? 0 : CACHE_LINE - misalignment);
+        }
+
+#ifdef CPP_ALG_BENCH_X86
+
+        // one cache line from src to dst with non-temporal stores
+
+        struct Sse2Stream {
+            SIMD_TARGET_SSE2 static auto line(std::byte *dst, const std::byte *src) -> void {
+                const auto s = reinterpret_cast<const __m128i *>(src);
+                const auto d = reinterpret_cast<__m128i *>(dst);
+                const auto x0 = _mm_loadu_si128(s), x1 = _mm_loadu_si128(s + 1);
+                const auto x2 = _mm_loadu_si128(s + 2), x3 = _mm_loadu_si128(s + 3);
+                _mm_stream_si128(d, x0);
+                _mm_stream_si128(d + 1, x1);
+                _mm_stream_si128(d + 2, x2);
+                _mm_stream_si128(d + 3, x3);
+            }
+        };
+
+        struct Avx2Stream {
+            SIMD_TARGET_AVX2 static auto line(std::byte *dst, const std::byte *src) -> void {
+                const auto s = reinterpret_cast<const __m256i *>(src);
+                const auto d = reinterpret_cast<__m256i *>(dst);
+                const auto x0 = _mm256_loadu_si256(s), x1 = _mm256_loadu_si256(s + 1);
+                _mm256_stream_si256(d, x0);
+                _mm256_stream_si256(d + 1, x1);
+            }
+        };
+
+        struct Avx512Stream {
+            SIMD_TARGET_AVX512 static auto line(std::byte *dst, const std::byte *src) -> void {
+                _mm512_stream_si512(reinterpret_cast<__m512i *>(dst), _mm512_loadu_si512(src));
+            }
+        };
+
+        // Non-temporal stores write whole lines through the write-combining buffers: no read-for-ownership of the
+        // destination and no eviction of the cached working set. The sfence orders them before later stores
+#define COPY_STREAM_KERNEL(isa, target, Ops)                                                                    \
+        target inline auto isa##_stream_copy(std::byte *dst, const std::byte *src, std::size_t bytes) -> void { \
+            const auto head = head_bytes(dst, bytes);                                                           \
+            std::memcpy(dst, src, head);                                                                        \
+            dst += head;                                                                                        \
+            src += head;                                                                                        \
+            bytes -= head;                                                                                      \
+                                                                                                                \
+            for (; bytes >= CACHE_LINE; dst += CACHE_LINE, src += CACHE_LINE, bytes -= CACHE_LINE) {            \
+                Ops##Stream::line(dst, src);                                                                    \
+            }                                                                                                   \
+            _mm_sfence();                                                                                       \
+            std::memcpy(dst, src, bytes);                                                                       \
+        }
+
+        SIMD_FOR_EACH_ISA(COPY_STREAM_KERNEL)
+
+#undef COPY_STREAM_KERNEL
+
+#endif
+
+        inline auto stream_copy(void *dst, const void *src, std::size_t bytes, simd::Isa isa) -> void {
+            // an empty range may come with null pointers, which memcpy must not see
+            if (bytes == 0) {
+                return;
+            }
+            const auto d = static_cast<std::byte *>(dst);
+            const auto s = static_cast<const std::byte *>(src);
+            switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+                case simd::Isa::avx512:
+                    return avx512_stream_copy(d, s, bytes);
+                case simd::Isa::avx2:
+                    return avx2_stream_copy(d, s, bytes);
+                case simd::Isa::sse2:
+                    return sse2_stream_copy(d, s, bytes);
+#endif
+                default:
+                    std::memcpy(d, s, bytes);
+            }
+        }
+
+    }
+
+    // copies of at least this many bytes in loop_alg bypass the caches
+    inline auto streaming_threshold() -> std::size_t {
+        return detail::streaming_threshold_ref().load(std::memory_order_relaxed);
+    }
+
+    // sets the streaming threshold to llc_fraction of the LLC size, never streams if the LLC size is unknown
+    inline auto set_streaming_llc_fraction(double llc_fraction) -> void {
+        detail::streaming_threshold_ref().store(detail::threshold_for(llc_fraction), std::memory_order_relaxed);
+    }
+
+    namespace detail {
+
+        inline auto bulk_copy(void *dst, const void *src, std::size_t bytes) -> void {
+            if (bytes == 0) {
+                return;
+            }
+            if (bytes >= streaming_threshold()) {
+                stream_copy(dst, src, bytes, simd::detect_isa());
+            } else {
+                std::memcpy(dst, src, bytes);
+            }
+        }
+
+    }
+
     template<
         std::input_iterator InputIt,
         std::output_iterator<typename std::iterator_traits<InputIt>::value_type> OutputIt
@@ -31,13 +219,23 @@ namespace copy {
             std::contiguous_iterator<OutputIt>
         ) {
             const auto size = std::distance(first, last);
-            std::memcpy(&(*d_first), &(*first), size * sizeof(value_type));
+            detail::bulk_copy(std::to_address(d_first), std::to_address(first), size * sizeof(value_type));
             return d_first + size;
         } else {
             return naive_loop_alg(first, last, d_first);
         }
     }
 
+    // always copies with non-temporal stores, for outputs that won't be read again soon
+    template<std::contiguous_iterator ContIt, std::contiguous_iterator DContIt>
+        requires std::is_trivially_copyable_v<std::iter_value_t<ContIt>> &&
+                 std::same_as<std::iter_value_t<ContIt>, std::iter_value_t<DContIt>>
+    auto stream_alg(ContIt first, ContIt last, DContIt d_first, simd::Isa isa = simd::detect_isa()) -> DContIt {
+        const auto size = std::distance(first, last);
+        detail::stream_copy(std::to_address(d_first), std::to_address(first), size * sizeof(std::iter_value_t<ContIt>), isa);
+        return d_first + size;
+    }
+
     template<
         std::random_access_iterator RandomIt,
         std::random_access_iterator DRandomIt
@@ -51,4 +249,318 @@ namespace copy {
         return d_first + n;
     }
 
+    namespace detail {
+
+        // chunk boundaries sit on destination page boundaries, so no two threads write into the same page
+        inline constexpr std::size_t PAGE_BYTES = 4'096;
+        // below this a chunk doesn't pay for waking up another thread
+        inline constexpr std::size_t MIN_CHUNK_BYTES = 256 * 1'024;
+
+        inline auto page_boundary(const std::byte *dst, std::size_t bytes, std::size_t c, std::size_t num_chunks) -> std::size_t {
+            if (c == 0) {
+                return 0;
+            }
+            if (c == num_chunks) {
+                return bytes;
+            }
+            const auto base = reinterpret_cast<std::uintptr_t>(dst);
+            const auto aligned = (base + bytes / num_chunks * c + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES;
+            return std::min<std::size_t>(aligned - base, bytes);
+        }
+
+        inline auto chunked_copy(void *dst, const void *src, std::size_t bytes, std::size_t num_chunks, bool stream) -> void {
+            const auto d = static_cast<std::byte *>(dst);
+            const auto s = static_cast<const std::byte *>(src);
+            const auto isa = simd::detect_isa();
+
+#pragma omp parallel for num_threads(static_cast<int>(num_chunks)) schedule(static, 1)
+            for (std::size_t c = 0; c < num_chunks; ++c) {
+                const auto begin = page_boundary(d, bytes, c, num_chunks);
+                const auto end = page_boundary(d, bytes, c + 1, num_chunks);
+                if (stream) {
+                    stream_copy(d + begin, s + begin, end - begin, isa);
+                } else {
+                    std::memcpy(d + begin, s + begin, end - begin);
+                }
+            }
+        }
+
+        inline auto num_copy_chunks(std::size_t bytes) -> std::size_t {
+            return std::clamp<std::size_t>(bytes / MIN_CHUNK_BYTES, 1, static_cast<std::size_t>(omp_get_max_threads()));
+        }
+
+        // Smallest power of two size (up to 16 MiB) where the chunked copy beats a single memcpy by 10%,
+        // best of a few runs each. Never parallel if it doesn't win at all or there is a single thread
+        inline auto calibrate_parallel_threshold() -> std::size_t {
+            constexpr std::size_t min_probe = 64 * 1'024, max_probe = 16 * 1'024 * 1'024;
+            constexpr int runs = 3;
+            if (omp_get_max_threads() == 1) {
+                return std::numeric_limits<std::size_t>::max();
+            }
+
+            std::vector<std::byte> src(max_probe, std::byte{1}), dst(max_probe, std::byte{0});
+            const auto best_time = [](const auto &f) {
+                auto best = std::chrono::steady_clock::duration::max();
+                for (int r = 0; r < runs; ++r) {
+                    const auto t_start = std::chrono::steady_clock::now();
+                    f();
+                    best = std::min(best, std::chrono::steady_clock::now() - t_start);
+                }
+                return best;
+            };
+
+            for (auto bytes = min_probe; bytes <= max_probe; bytes *= 2) {
+                const auto serial = best_time([&] { std::memcpy(dst.data(), src.data(), bytes); });
+                const auto parallel = best_time([&] {
+                    chunked_copy(dst.data(), src.data(), bytes, num_copy_chunks(bytes), false);
+                });
+                if (parallel * 10 < serial * 9) {
+                    return bytes;
+                }
+            }
+            return std::numeric_limits<std::size_t>::max();
+        }
+
+        inline auto parallel_threshold_ref() -> std::atomic<std::size_t> & {
+            static std::atomic<std::size_t> threshold{calibrate_parallel_threshold()};
+            return threshold;
+        }
+
+        inline auto parallel_bulk_copy(void *dst, const void *src, std::size_t bytes) -> void {
+            const auto num_chunks = num_copy_chunks(bytes);
+            if (num_chunks == 1 || bytes < parallel_threshold_ref().load(std::memory_order_relaxed)) {
+                bulk_copy(dst, src, bytes);
+            } else {
+                chunked_copy(dst, src, bytes, num_chunks, bytes >= streaming_threshold());
+            }
+        }
+
+    }
+
+    // copies of at least this many bytes in openmp_memcpy_alg are split across threads,
+    // measured on the first call unless set explicitly
+    inline auto parallel_copy_threshold() -> std::size_t {
+        return detail::parallel_threshold_ref().load(std::memory_order_relaxed);
+    }
+
+    inline auto set_parallel_copy_threshold(std::size_t bytes) -> void {
+        detail::parallel_threshold_ref().store(bytes, std::memory_order_relaxed);
+    }
+
+    // Parallel copy of a trivially copyable range: page-aligned chunks with one memcpy (or streaming
+    // kernel above the streaming threshold) per thread, loop_alg for copies below the parallel threshold
+    template<std::contiguous_iterator ContIt, std::contiguous_iterator DContIt>
+        requires std::is_trivially_copyable_v<std::iter_value_t<ContIt>> &&
+                 std::same_as<std::iter_value_t<ContIt>, std::iter_value_t<DContIt>>
+    auto openmp_memcpy_alg(ContIt first, ContIt last, DContIt d_first) -> DContIt {
+        const auto size = std::distance(first, last);
+        detail::parallel_bulk_copy(std::to_address(d_first), std::to_address(first), size * sizeof(std::iter_value_t<ContIt>));
+        return d_first + size;
+    }
+
+    // FlatStringVector copies: the offset table and the character arena are copied as two bulk copies,
+    // dst keeps its buffers when they are already large enough
+    inline auto flat_loop_alg(const flat_str::FlatStringVector &src, flat_str::FlatStringVector &dst) -> void {
+        dst.resize_raw(src.size(), src.chars().size());
+        loop_alg(std::cbegin(src.offsets()), std::cend(src.offsets()), std::begin(dst.offsets()));
+        loop_alg(std::cbegin(src.chars()), std::cend(src.chars()), std::begin(dst.chars()));
+    }
+
+    inline auto flat_openmp_alg(const flat_str::FlatStringVector &src, flat_str::FlatStringVector &dst) -> void {
+        dst.resize_raw(src.size(), src.chars().size());
+        openmp_memcpy_alg(std::cbegin(src.offsets()), std::cend(src.offsets()), std::begin(dst.offsets()));
+        openmp_memcpy_alg(std::cbegin(src.chars()), std::cend(src.chars()), std::begin(dst.chars()));
+    }
+
+    // One memory resource per OpenMP thread (monotonic_buffer_resource, unsynchronized_pool_resource, ...),
+    // each on its own cache lines and drawing from upstream in big blocks, so workers never share an allocator
+    template<typename Resource = std::pmr::monotonic_buffer_resource>
+    class ThreadResources {
+    public:
+        explicit ThreadResources(
+            std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads()),
+            std::pmr::memory_resource *upstream = std::pmr::new_delete_resource()
+        ) {
+            slots_.reserve(std::max<std::size_t>(num_threads, 1));
+            for (std::size_t t = 0; t < std::max<std::size_t>(num_threads, 1); ++t) {
+                slots_.push_back(std::make_unique<Slot>(upstream));
+            }
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return slots_.size();
+        }
+
+        auto operator[](std::size_t thread) -> Resource & {
+            return slots_[thread]->resource;
+        }
+
+        // everything allocated from the resources must be destroyed before release()
+        auto release() -> void {
+            for (auto &slot: slots_) {
+                slot->resource.release();
+            }
+        }
+
+    private:
+        struct alignas(64) Slot {
+            explicit Slot(std::pmr::memory_resource *upstream) : resource(upstream) {}
+
+            Resource resource;
+        };
+
+        std::vector<std::unique_ptr<Slot>> slots_;
+    };
+
+    // Copy-constructs [first, last) into the uninitialized storage at d_first with uses-allocator construction,
+    // so allocator-aware elements like std::pmr::string allocate from resource
+    template<std::input_iterator InputIt, std::forward_iterator ForwardIt>
+    auto pmr_loop_alg(InputIt first, InputIt last, ForwardIt d_first, std::pmr::memory_resource &resource) -> ForwardIt {
+        const std::pmr::polymorphic_allocator<> alloc(&resource);
+        for (; first != last; ++first, ++d_first) {
+            std::uninitialized_construct_using_allocator(std::to_address(d_first), alloc, *first);
+        }
+        return d_first;
+    }
+
+    // Parallel pmr_loop_alg: every worker constructs its elements from its own slot of `resources`
+    // instead of all of them contending on the global allocator
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename Resource>
+    auto openmp_pmr_alg(RandIt first, RandIt last, DRandIt d_first, ThreadResources<Resource> &resources) -> DRandIt {
+        const auto n = std::distance(first, last);
+
+#pragma omp parallel num_threads(static_cast<int>(resources.size()))
+        {
+            const std::pmr::polymorphic_allocator<> alloc(&resources[static_cast<std::size_t>(omp_get_thread_num())]);
+#pragma omp for schedule(static)
+            for (std::iter_difference_t<RandIt> i = 0; i < n; ++i) {
+                std::uninitialized_construct_using_allocator(std::to_address(d_first + i), alloc, first[i]);
+            }
+        }
+        return d_first + n;
+    }
+
+    // Types whose objects can be moved to a new address with a memcpy, leaving the old bytes to be discarded
+    // without running the destructor. Specialize it for own types that qualify.
+    // libstdc++'s std::string does not: its short string buffer is pointed to from inside the object
+    template<typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template<typename T>
+    struct is_trivially_relocatable<std::vector<T>> : std::true_type {};
+
+    template<typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    namespace detail {
+
+        template<typename InputIt, typename OutputIt>
+        concept BitwiseCopyable = std::contiguous_iterator<InputIt> && std::contiguous_iterator<OutputIt> &&
+                                  std::same_as<std::iter_value_t<InputIt>, std::iter_value_t<OutputIt>>;
+
+    }
+
+    // Constructs copies of [first, last) in the uninitialized storage at d_first,
+    // a bulk copy for trivially copyable elements. If a copy throws, the constructed ones are destroyed
+    template<std::input_iterator InputIt, std::forward_iterator ForwardIt>
+    auto uninitialized_copy_alg(InputIt first, InputIt last, ForwardIt d_first) -> ForwardIt {
+        if constexpr (
+            detail::BitwiseCopyable<InputIt, ForwardIt> && std::is_trivially_copyable_v<std::iter_value_t<InputIt>>
+        ) {
+            return loop_alg(first, last, d_first);
+        } else {
+            return std::uninitialized_copy(first, last, d_first);
+        }
+    }
+
+    template<std::input_iterator InputIt, std::forward_iterator ForwardIt>
+    auto uninitialized_move_alg(InputIt first, InputIt last, ForwardIt d_first) -> ForwardIt {
+        if constexpr (
+            detail::BitwiseCopyable<InputIt, ForwardIt> && std::is_trivially_copyable_v<std::iter_value_t<InputIt>>
+        ) {
+            return loop_alg(first, last, d_first);
+        } else {
+            return std::uninitialized_move(first, last, d_first);
+        }
+    }
+
+    // Moves [first, last) into the uninitialized storage at d_first and ends the lifetime of the sources,
+    // which become raw storage. Trivially relocatable elements are a bulk copy with no destructor calls.
+    // If a throwing move fails, the sources are left intact and the new objects are destroyed
+    template<std::forward_iterator ForwardIt, std::forward_iterator DForwardIt>
+    auto relocate_alg(ForwardIt first, ForwardIt last, DForwardIt d_first) -> DForwardIt {
+        using value_type = std::iter_value_t<ForwardIt>;
+
+        if constexpr (detail::BitwiseCopyable<ForwardIt, DForwardIt> && is_trivially_relocatable_v<value_type>) {
+            const auto size = std::distance(first, last);
+            detail::bulk_copy(std::to_address(d_first), std::to_address(first), size * sizeof(value_type));
+            return d_first + size;
+        } else if constexpr (std::is_nothrow_move_constructible_v<value_type>) {
+            for (; first != last; ++first, ++d_first) {
+                std::construct_at(std::to_address(d_first), std::move(*first));
+                std::destroy_at(std::to_address(first));
+            }
+            return d_first;
+        } else {
+            const auto d_last = std::uninitialized_move(first, last, d_first);
+            std::destroy(first, last);
+            return d_last;
+        }
+    }
+
+    // Parallel versions: bulk copies go through openmp_memcpy_alg, other elements are constructed by
+    // a static split over the threads. Like the parallel std algorithms, an exception calls std::terminate
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt>
+    auto openmp_uninitialized_copy_alg(RandIt first, RandIt last, DRandIt d_first) -> DRandIt {
+        if constexpr (
+            detail::BitwiseCopyable<RandIt, DRandIt> && std::is_trivially_copyable_v<std::iter_value_t<RandIt>>
+        ) {
+            return openmp_memcpy_alg(first, last, d_first);
+        } else {
+            const auto n = std::distance(first, last);
+#pragma omp parallel for schedule(static)
+            for (std::iter_difference_t<RandIt> i = 0; i < n; ++i) {
+                std::construct_at(std::to_address(d_first + i), first[i]);
+            }
+            return d_first + n;
+        }
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt>
+    auto openmp_uninitialized_move_alg(RandIt first, RandIt last, DRandIt d_first) -> DRandIt {
+        if constexpr (
+            detail::BitwiseCopyable<RandIt, DRandIt> && std::is_trivially_copyable_v<std::iter_value_t<RandIt>>
+        ) {
+            return openmp_memcpy_alg(first, last, d_first);
+        } else {
+            const auto n = std::distance(first, last);
+#pragma omp parallel for schedule(static)
+            for (std::iter_difference_t<RandIt> i = 0; i < n; ++i) {
+                std::construct_at(std::to_address(d_first + i), std::move(first[i]));
+            }
+            return d_first + n;
+        }
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt>
+    auto openmp_relocate_alg(RandIt first, RandIt last, DRandIt d_first) -> DRandIt {
+        using value_type = std::iter_value_t<RandIt>;
+
+        const auto n = std::distance(first, last);
+        if constexpr (detail::BitwiseCopyable<RandIt, DRandIt> && is_trivially_relocatable_v<value_type>) {
+            detail::parallel_bulk_copy(std::to_address(d_first), std::to_address(first), n * sizeof(value_type));
+        } else {
+#pragma omp parallel for schedule(static)
+            for (std::iter_difference_t<RandIt> i = 0; i < n; ++i) {
+                std::construct_at(std::to_address(d_first + i), std::move(first[i]));
+                std::destroy_at(std::to_address(first + i));
+            }
+        }
+        return d_first + n;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace flat_str {
+
+    namespace detail {
+
+        // std::allocator that default-initializes on resize(), so raw storage is not zero-filled before a bulk copy
+        template<typename T>
+        struct DefaultInitAllocator : std::allocator<T> {
+            using std::allocator<T>::allocator;
+
+            template<typename U>
+            auto construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>) -> void {
+                ::new(static_cast<void *>(p)) U;
+            }
+
+            template<typename U, typename... Args>
+            auto construct(U *p, Args &&... args) -> void {
+                std::construct_at(p, std::forward<Args>(args)...);
+            }
+        };
+
+    }
+
+    // Strings stored back to back in one character arena, the i-th string spans [offsets[i], offsets[i + 1]).
+    // Copying the whole container is two bulk copies instead of an allocation per string.
+    // A moved-from container has no offsets at all and behaves as an empty one
+    class FlatStringVector {
+    public:
+        class const_iterator {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::string_view;
+
+            const_iterator() = default;
+
+            const_iterator(const FlatStringVector *owner, std::size_t idx) : owner_(owner), idx_(idx) {}
+
+            auto operator*() const -> reference { return (*owner_)[idx_]; }
+
+            auto operator[](difference_type n) const -> reference { return (*owner_)[idx_ + n]; }
+
+            auto operator++() -> const_iterator & {
+                ++idx_;
+                return *this;
+            }
+
+            auto operator++(int) -> const_iterator {
+                auto tmp = *this;
+                ++idx_;
+                return tmp;
+            }
+
+            auto operator--() -> const_iterator & {
+                --idx_;
+                return *this;
+            }
+
+            auto operator--(int) -> const_iterator {
+                auto tmp = *this;
+                --idx_;
+                return tmp;
+            }
+
+            auto operator+=(difference_type n) -> const_iterator & {
+                idx_ += n;
+                return *this;
+            }
+
+            auto operator-=(difference_type n) -> const_iterator & {
+                idx_ -= n;
+                return *this;
+            }
+
+            friend auto operator+(const_iterator it, difference_type n) -> const_iterator { return it += n; }
+
+            friend auto operator+(difference_type n, const_iterator it) -> const_iterator { return it += n; }
+
+            friend auto operator-(const_iterator it, difference_type n) -> const_iterator { return it -= n; }
+
+            friend auto operator-(const const_iterator &lhs, const const_iterator &rhs) -> difference_type {
+                return static_cast<difference_type>(lhs.idx_) - static_cast<difference_type>(rhs.idx_);
+            }
+
+            friend auto operator==(const const_iterator &lhs, const const_iterator &rhs) -> bool {
+                return lhs.idx_ == rhs.idx_;
+            }
+
+            friend auto operator<=>(const const_iterator &lhs, const const_iterator &rhs) -> std::strong_ordering {
+                return lhs.idx_ <=> rhs.idx_;
+            }
+
+        private:
+            const FlatStringVector *owner_ = nullptr;
+            std::size_t idx_ = 0;
+        };
+
+        using iterator = const_iterator;
+        using value_type = std::string_view;
+        using size_type = std::size_t;
+
+        FlatStringVector() = default;
+
+        template<std::ranges::input_range R> requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+        explicit FlatStringVector(const R &strings) {
+            for (const auto &s: strings) {
+                push_back(s);
+            }
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return offsets_.empty() ? 0 : offsets_.size() - 1;
+        }
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return size() == 0;
+        }
+
+        auto operator[](std::size_t idx) const -> std::string_view {
+            return {chars_.data() + offsets_[idx], offsets_[idx + 1] - offsets_[idx]};
+        }
+
+        auto push_back(std::string_view s) -> void {
+            if (offsets_.empty()) {
+                offsets_.push_back(0);
+            }
+            chars_.insert(std::end(chars_), std::begin(s), std::end(s));
+            offsets_.push_back(chars_.size());
+        }
+
+        auto reserve(std::size_t num_strings, std::size_t num_chars) -> void {
+            offsets_.reserve(num_strings + 1);
+            chars_.reserve(num_chars);
+        }
+
+        auto clear() noexcept -> void {
+            chars_.clear();
+            if (!offsets_.empty()) {
+                offsets_.erase(std::begin(offsets_) + 1, std::end(offsets_));
+            }
+        }
+
+        [[nodiscard]] auto begin() const -> const_iterator {
+            return {this, 0};
+        }
+
+        [[nodiscard]] auto end() const -> const_iterator {
+            return {this, size()};
+        }
+
+        // raw storage for bulk algorithms: size() + 1 offsets and offsets().back() characters
+        [[nodiscard]] auto chars() const noexcept -> std::span<const char> {
+            return chars_;
+        }
+
+        [[nodiscard]] auto chars() noexcept -> std::span<char> {
+            return chars_;
+        }
+
+        [[nodiscard]] auto offsets() const noexcept -> std::span<const std::size_t> {
+            if (offsets_.empty()) {
+                return empty_offsets_;
+            }
+            return offsets_;
+        }
+
+        [[nodiscard]] auto offsets() noexcept -> std::span<std::size_t> {
+            return offsets_;
+        }
+
+        // resizes the raw storage without initializing it, the content stays invalid until both arrays are overwritten
+        auto resize_raw(std::size_t num_strings, std::size_t num_chars) -> void {
+            offsets_.resize(num_strings + 1);
+            chars_.resize(num_chars);
+        }
+
+        friend auto operator==(const FlatStringVector &lhs, const FlatStringVector &rhs) -> bool {
+            return std::ranges::equal(lhs.offsets(), rhs.offsets()) && lhs.chars_ == rhs.chars_;
+        }
+
+    private:
+        static constexpr std::size_t empty_offsets_[1] = {0};
+
+        std::vector<char, detail::DefaultInitAllocator<char>> chars_;
+        std::vector<std::size_t, detail::DefaultInitAllocator<std::size_t>> offsets_{0};
+    };
+
+}
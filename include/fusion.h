@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#include "thread_pool.h"
+
+namespace fusion {
+
+    // Lazy pipelines: pipe(src) | map(f) | zip(other, g) | reduce(init, op) builds a nested expression type
+    // where element i is computed on demand as g(f(src[i]), other[i]), and the terminal reduce folds it in
+    // one loop. No intermediate vector is written or reread between the stages.
+    // Expressions hold iterators to the sources, which have to outlive the pipeline
+
+    template<typename Expr>
+    concept Expression = requires(const Expr &expr, std::size_t i) {
+        { expr.size() } -> std::convertible_to<std::size_t>;
+        expr[i];
+    };
+
+    template<std::random_access_iterator RandIt>
+    class Source {
+    public:
+        Source(RandIt first, std::size_t size) : first_(first), size_(size) {}
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return size_;
+        }
+
+        auto operator[](std::size_t i) const -> decltype(auto) {
+            return first_[i];
+        }
+
+    private:
+        RandIt first_;
+        std::size_t size_;
+    };
+
+    template<Expression Expr, typename UnaryOp>
+    class Map {
+    public:
+        Map(Expr expr, UnaryOp op) : expr_(std::move(expr)), op_(std::move(op)) {}
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return expr_.size();
+        }
+
+        auto operator[](std::size_t i) const {
+            return std::invoke(op_, expr_[i]);
+        }
+
+    private:
+        Expr expr_;
+        UnaryOp op_;
+    };
+
+    // the second operand is read at the same index and has to hold at least size() elements, like zip::loop_alg
+    template<Expression Expr, std::random_access_iterator RandIt, typename BinaryOp>
+    class Zip {
+    public:
+        Zip(Expr expr, RandIt first2, BinaryOp op) : expr_(std::move(expr)), first2_(first2), op_(std::move(op)) {}
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return expr_.size();
+        }
+
+        auto operator[](std::size_t i) const {
+            return std::invoke(op_, expr_[i], first2_[i]);
+        }
+
+    private:
+        Expr expr_;
+        RandIt first2_;
+        BinaryOp op_;
+    };
+
+    template<std::random_access_iterator RandIt>
+    auto pipe(RandIt first, RandIt last) -> Source<RandIt> {
+        return {first, static_cast<std::size_t>(std::distance(first, last))};
+    }
+
+    template<std::ranges::random_access_range Range>
+    auto pipe(Range &range) -> Source<std::ranges::iterator_t<Range>> {
+        return pipe(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    // stages, bound to an expression by operator|
+
+    template<typename UnaryOp>
+    struct MapStage {
+        UnaryOp op;
+    };
+
+    template<std::random_access_iterator RandIt, typename BinaryOp>
+    struct ZipStage {
+        RandIt first2;
+        BinaryOp op;
+    };
+
+    namespace backend {
+
+        struct serial {};
+
+        struct openmp {};
+
+        struct pool {
+            thread_pool::ThreadPool *pool;
+        };
+
+    }
+
+    template<typename Value, typename BinaryOp, typename Backend>
+    struct ReduceStage {
+        Value init;
+        BinaryOp op;
+        Backend backend;
+    };
+
+    template<typename UnaryOp>
+    auto map(UnaryOp op) -> MapStage<UnaryOp> {
+        return {std::move(op)};
+    }
+
+    template<std::random_access_iterator RandIt, typename BinaryOp>
+    auto zip(RandIt first2, BinaryOp op) -> ZipStage<RandIt, BinaryOp> {
+        return {first2, std::move(op)};
+    }
+
+    template<std::ranges::random_access_range Range, typename BinaryOp>
+    auto zip(Range &range, BinaryOp op) -> ZipStage<std::ranges::iterator_t<Range>, BinaryOp> {
+        return {std::ranges::begin(range), std::move(op)};
+    }
+
+    // left fold over the elements in index order, like reduce::acc_loop_alg
+    template<typename Value, typename BinaryOp = std::plus<>>
+    auto reduce(Value init, BinaryOp op = {}) -> ReduceStage<Value, BinaryOp, backend::serial> {
+        return {std::move(init), std::move(op), {}};
+    }
+
+    // Contiguous blocks, one per thread, each seeded with its own first element like reduce::pool_reduce,
+    // so op has to be associative but needs no identity. The block partials are folded into init in order
+    template<typename Value, typename BinaryOp = std::plus<>>
+    auto openmp_reduce(Value init, BinaryOp op = {}) -> ReduceStage<Value, BinaryOp, backend::openmp> {
+        return {std::move(init), std::move(op), {}};
+    }
+
+    // same blocks as openmp_reduce on the persistent pool
+    template<typename Value, typename BinaryOp = std::plus<>>
+    auto pool_reduce(
+        Value init, BinaryOp op = {}, thread_pool::ThreadPool &pool = thread_pool::instance()
+    ) -> ReduceStage<Value, BinaryOp, backend::pool> {
+        return {std::move(init), std::move(op), {&pool}};
+    }
+
+    template<Expression Expr, typename UnaryOp>
+    auto operator|(Expr expr, MapStage<UnaryOp> stage) -> Map<Expr, UnaryOp> {
+        return {std::move(expr), std::move(stage.op)};
+    }
+
+    template<Expression Expr, std::random_access_iterator RandIt, typename BinaryOp>
+    auto operator|(Expr expr, ZipStage<RandIt, BinaryOp> stage) -> Zip<Expr, RandIt, BinaryOp> {
+        return {std::move(expr), stage.first2, std::move(stage.op)};
+    }
+
+    namespace detail {
+
+        // blocks shorter than this aren't worth a thread
+        inline constexpr std::size_t MIN_BLOCK = 4'096;
+
+        template<Expression Expr, typename Value, typename BinaryOp>
+        auto fold(const Expr &expr, std::size_t first, std::size_t last, Value init, const BinaryOp &op) -> Value {
+            for (auto i = first; i != last; ++i) {
+                init = std::invoke(op, std::move(init), expr[i]);
+            }
+            return init;
+        }
+
+        inline auto block_count(std::size_t size, std::size_t concurrency) -> std::size_t {
+            return std::max<std::size_t>(std::min(concurrency, size / MIN_BLOCK), 1);
+        }
+
+        template<Expression Expr, typename Value, typename BinaryOp>
+        auto fold_block(
+            const Expr &expr, std::size_t b, std::size_t num_blocks, const BinaryOp &op
+        ) -> Value {
+            const auto size = expr.size();
+            const auto block_size = size / num_blocks;
+            const auto first = b * block_size;
+            const auto last = b == num_blocks - 1 ? size : first + block_size;
+            return fold(expr, first + 1, last, Value(expr[first]), op);
+        }
+
+        template<typename Value, typename BinaryOp>
+        auto fold_partials(const std::vector<Value> &partials, Value init, const BinaryOp &op) -> Value {
+            for (const auto &partial: partials) {
+                init = std::invoke(op, std::move(init), partial);
+            }
+            return init;
+        }
+
+        template<Expression Expr, typename Value, typename BinaryOp>
+        auto run(const Expr &expr, ReduceStage<Value, BinaryOp, backend::serial> stage) -> Value {
+            return fold(expr, 0, expr.size(), std::move(stage.init), stage.op);
+        }
+
+        template<Expression Expr, typename Value, typename BinaryOp>
+        auto run(const Expr &expr, ReduceStage<Value, BinaryOp, backend::openmp> stage) -> Value {
+            const auto num_blocks = block_count(expr.size(), omp_get_max_threads());
+            if (num_blocks == 1) {
+                return fold(expr, 0, expr.size(), std::move(stage.init), stage.op);
+            }
+
+            std::vector<Value> partials(num_blocks);
+#pragma omp parallel for num_threads(num_blocks) schedule(static, 1)
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                partials[b] = fold_block<Expr, Value>(expr, b, num_blocks, stage.op);
+            }
+            return fold_partials(partials, std::move(stage.init), stage.op);
+        }
+
+        template<Expression Expr, typename Value, typename BinaryOp>
+        auto run(const Expr &expr, ReduceStage<Value, BinaryOp, backend::pool> stage) -> Value {
+            auto &pool = *stage.backend.pool;
+            const auto num_blocks = block_count(expr.size(), pool.concurrency());
+            if (num_blocks == 1) {
+                return fold(expr, 0, expr.size(), std::move(stage.init), stage.op);
+            }
+
+            std::vector<Value> partials(num_blocks);
+            pool.parallel_for(0, num_blocks, 1, [&](std::size_t b_first, std::size_t b_last) {
+                for (auto b = b_first; b != b_last; ++b) {
+                    partials[b] = fold_block<Expr, Value>(expr, b, num_blocks, stage.op);
+                }
+            });
+            return fold_partials(partials, std::move(stage.init), stage.op);
+        }
+
+    }
+
+    // the terminal stage runs the whole pipeline
+    template<Expression Expr, typename Value, typename BinaryOp, typename Backend>
+    auto operator|(const Expr &expr, ReduceStage<Value, BinaryOp, Backend> stage) -> Value {
+        return detail::run(expr, std::move(stage));
+    }
+
+}
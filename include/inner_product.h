@@ -1,7 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <concepts>
 #include <iterator>
 #include <functional>
+#include <vector>
+
+#include <omp.h>
+
+#include "simd.h"
 
 namespace inner_prod {
 
@@ -43,4 +51,366 @@ namespace inner_prod {
         return init;
     }
 
-}
\ No newline at end of file
+    // generic version: per-thread partials over static chunks, folded in thread order, so op1 only has to be
+    // associative and Value can be any copyable type
+    template<
+        std::random_access_iterator RandIt1, std::random_access_iterator RandIt2,
+        typename Value,
+        typename BinaryOp1, typename BinaryOp2
+    >
+    auto openmp_alg(
+        RandIt1 first1, RandIt1 last1,
+        RandIt2 first2,
+        Value init,
+        BinaryOp1 op1, BinaryOp2 op2,
+        Value identity
+    ) -> Value {
+        const auto size = std::distance(first1, last1);
+        std::vector<Value> partials(omp_get_max_threads(), identity);
+
+#pragma omp parallel
+        {
+            Value partial = identity;
+#pragma omp for schedule(static) nowait
+            for (std::ptrdiff_t i = 0; i < size; ++i) {
+                partial = std::invoke(op1, std::move(partial), std::invoke(op2, first1[i], first2[i]));
+            }
+            partials[omp_get_thread_num()] = std::move(partial);
+        }
+
+        for (auto &partial: partials) {
+            init = std::invoke(op1, std::move(init), std::move(partial));
+        }
+        return init;
+    }
+
+    namespace detail {
+
+        // independent vector accumulators, enough to cover fma latency times the number of fma ports
+        inline constexpr std::size_t SIMD_ACCUMULATORS = 8;
+
+        // Value is the accumulator, Storage the element type that is widened to it (the same type for simd_alg)
+        template<typename Value, typename Storage>
+        auto scalar_dot(const Storage *p1, const Storage *p2, std::size_t n, Value init) -> Value {
+            for (std::size_t i = 0; i < n; ++i) {
+                init += static_cast<Value>(p1[i]) * static_cast<Value>(p2[i]);
+            }
+            return init;
+        }
+
+        template<typename Ops, typename Storage>
+        concept dot_kernel = requires(const Storage *p, typename Ops::reg r) {
+            Ops::hsum(Ops::add(r, Ops::fmadd(Ops::load(p), Ops::load(p), r)));
+        };
+
+#ifdef CPP_ALG_BENCH_X86
+
+#define INNER_PROD_DOT_KERNEL(isa, target, Ops)                                               \
+        template<typename Value, typename Storage>                                            \
+        target auto isa##_dot(const Storage *p1, const Storage *p2, std::size_t n) -> Value { \
+            using ops = simd::Ops<Value>;                                                     \
+            constexpr auto step = SIMD_ACCUMULATORS * ops::width;                             \
+                                                                                              \
+            typename ops::reg acc[SIMD_ACCUMULATORS];                                         \
+            for (auto &a: acc) {                                                              \
+                a = ops::zero();                                                              \
+            }                                                                                 \
+                                                                                              \
+            std::size_t i = 0;                                                                \
+            for (; i + step <= n; i += step) {                                                \
+                _Pragma("GCC unroll 8")                                                       \
+                for (std::size_t k = 0; k < SIMD_ACCUMULATORS; ++k) {                         \
+                    const auto off = i + k * ops::width;                                      \
+                    acc[k] = ops::fmadd(ops::load(p1 + off), ops::load(p2 + off), acc[k]);    \
+                }                                                                             \
+            }                                                                                 \
+            for (; i + ops::width <= n; i += ops::width) {                                    \
+                acc[0] = ops::fmadd(ops::load(p1 + i), ops::load(p2 + i), acc[0]);            \
+            }                                                                                 \
+                                                                                              \
+            for (auto w = SIMD_ACCUMULATORS / 2; w != 0; w /= 2) {                            \
+                for (std::size_t k = 0; k < w; ++k) {                                         \
+                    acc[k] = ops::add(acc[k], acc[k + w]);                                    \
+                }                                                                             \
+            }                                                                                 \
+            return scalar_dot(p1 + i, p2 + i, n - i, ops::hsum(acc[0]));                      \
+        }
+
+        SIMD_FOR_EACH_ISA(INNER_PROD_DOT_KERNEL)
+
+#undef INNER_PROD_DOT_KERNEL
+
+#endif
+
+        // an instruction set without a widening load for Storage falls through to the next narrower one
+        template<typename Value, typename Storage>
+        auto simd_dot(const Storage *p1, const Storage *p2, std::size_t n, simd::Isa isa) -> Value {
+            switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+                case simd::Isa::avx512:
+                    if constexpr (dot_kernel<simd::Avx512<Value>, Storage>) {
+                        return avx512_dot<Value>(p1, p2, n);
+                    }
+                    [[fallthrough]];
+                case simd::Isa::avx2:
+                    if constexpr (dot_kernel<simd::Avx2<Value>, Storage>) {
+                        return avx2_dot<Value>(p1, p2, n);
+                    }
+                    [[fallthrough]];
+                case simd::Isa::sse2:
+                    if constexpr (dot_kernel<simd::Sse2<Value>, Storage>) {
+                        return sse2_dot<Value>(p1, p2, n);
+                    }
+                    [[fallthrough]];
+#endif
+                default:
+                    return scalar_dot(p1, p2, n, Value{});
+            }
+        }
+
+    }
+
+    // Hand-vectorized dot product of contiguous float/double ranges: independent FMA accumulators instead of
+    // the single dependent chain of loop_alg (no FMA before AVX2, there it is a multiply and an add).
+    // The summation order differs from a serial loop, so the result may differ in the last bits
+    template<std::contiguous_iterator ContIt1, std::contiguous_iterator ContIt2>
+    requires std::floating_point<std::iter_value_t<ContIt1>> &&
+             std::same_as<std::iter_value_t<ContIt1>, std::iter_value_t<ContIt2>>
+    auto simd_alg(
+        ContIt1 first1, ContIt1 last1,
+        ContIt2 first2,
+        std::iter_value_t<ContIt1> init,
+        simd::Isa isa = simd::detect_isa()
+    ) -> std::iter_value_t<ContIt1> {
+        const auto n = static_cast<std::size_t>(std::distance(first1, last1));
+        return init + detail::simd_dot<std::iter_value_t<ContIt1>>(std::to_address(first1), std::to_address(first2), n, isa);
+    }
+
+    // Mixed precision dot product: the ranges store a narrow type (simd::float16, simd::bfloat16, float, int8_t,
+    // int16_t, ...) and the kernels of simd_alg widen every element to the accumulator type Acc of init before
+    // the multiply-add. Memory traffic is that of the storage type, rounding error and overflow range those of
+    // Acc: int8/int16 products are exact in int32 lanes and int32 products in int64 lanes
+    template<std::contiguous_iterator ContIt1, std::contiguous_iterator ContIt2, typename Acc>
+    requires std::same_as<std::iter_value_t<ContIt1>, std::iter_value_t<ContIt2>> &&
+             simd::widens_to<std::iter_value_t<ContIt1>, Acc>
+    auto mixed_alg(
+        ContIt1 first1, ContIt1 last1,
+        ContIt2 first2,
+        Acc init,
+        simd::Isa isa = simd::detect_isa()
+    ) -> Acc {
+        const auto n = static_cast<std::size_t>(std::distance(first1, last1));
+        return init + detail::simd_dot<Acc>(std::to_address(first1), std::to_address(first2), n, isa);
+    }
+
+    // one contiguous block per thread through the mixed_alg kernels
+    template<std::contiguous_iterator ContIt1, std::contiguous_iterator ContIt2, typename Acc>
+    requires std::same_as<std::iter_value_t<ContIt1>, std::iter_value_t<ContIt2>> &&
+             simd::widens_to<std::iter_value_t<ContIt1>, Acc>
+    auto mixed_openmp_alg(
+        ContIt1 first1, ContIt1 last1,
+        ContIt2 first2,
+        Acc init,
+        simd::Isa isa = simd::detect_isa()
+    ) -> Acc {
+        const auto n = static_cast<std::size_t>(std::distance(first1, last1));
+        const auto p1 = std::to_address(first1);
+        const auto p2 = std::to_address(first2);
+#pragma omp parallel reduction(+:init)
+        {
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+            const auto tid = static_cast<std::size_t>(omp_get_thread_num());
+            const auto b_first = n * tid / num_threads;
+            const auto b_last = n * (tid + 1) / num_threads;
+            init += detail::simd_dot<Acc>(p1 + b_first, p2 + b_first, b_last - b_first, isa);
+        }
+        return init;
+    }
+
+    namespace detail {
+
+        // Batched dot products are a matrix product, blocked the usual way: a tile of R rows times Q queries keeps
+        // its R * Q accumulators in registers, so each loaded query chunk is reused by R rows and each row chunk
+        // by Q queries. Columns are walked in BATCH_COLS_BYTES chunks and rows in BATCH_ROW_BLOCK blocks, so
+        // the chunks of a row block stay in L2 while every query tile goes over them
+        inline constexpr std::size_t BATCH_COLS_BYTES = 8'192;
+        inline constexpr std::size_t BATCH_ROW_BLOCK = 16;
+
+        // tiles of one query against BATCH_SINGLE_ROWS rows, of BATCH_QUERIES queries against BATCH_ROWS rows,
+        // both with 8 accumulators
+        inline constexpr std::size_t BATCH_SINGLE_ROWS = 8;
+        inline constexpr std::size_t BATCH_ROWS = 4;
+        inline constexpr std::size_t BATCH_QUERIES = 2;
+
+        // out[j * num_rows + i] += dot of the first n elements of rows[i] and queries[j], for i < R, j < Q
+
+        struct ScalarTiles {
+            template<std::size_t R, std::size_t Q, std::floating_point Value>
+            static auto tile(
+                const Value *rows, std::size_t row_stride, const Value *queries, std::size_t query_stride,
+                std::size_t n, Value *out, std::size_t num_rows
+            ) -> void {
+                Value acc[R][Q]{};
+                for (std::size_t k = 0; k < n; ++k) {
+                    for (std::size_t i = 0; i < R; ++i) {
+                        for (std::size_t j = 0; j < Q; ++j) {
+                            acc[i][j] += rows[i * row_stride + k] * queries[j * query_stride + k];
+                        }
+                    }
+                }
+                for (std::size_t i = 0; i < R; ++i) {
+                    for (std::size_t j = 0; j < Q; ++j) {
+                        out[j * num_rows + i] += acc[i][j];
+                    }
+                }
+            }
+        };
+
+#ifdef CPP_ALG_BENCH_X86
+
+#define INNER_PROD_TILE_KERNEL(isa, target, Ops)                                                                       \
+        struct Ops##Tiles {                                                                                            \
+            template<std::size_t R, std::size_t Q, std::floating_point Value>                                          \
+            target static auto tile(                                                                                   \
+                const Value *rows, std::size_t row_stride, const Value *queries, std::size_t query_stride,             \
+                std::size_t n, Value *out, std::size_t num_rows                                                        \
+            ) -> void {                                                                                                \
+                using ops = simd::Ops<Value>;                                                                          \
+                                                                                                                       \
+                typename ops::reg acc[R][Q];                                                                           \
+                _Pragma("GCC unroll 8")                                                                                \
+                for (std::size_t i = 0; i < R; ++i) {                                                                  \
+                    for (std::size_t j = 0; j < Q; ++j) {                                                              \
+                        acc[i][j] = ops::zero();                                                                       \
+                    }                                                                                                  \
+                }                                                                                                      \
+                                                                                                                       \
+                std::size_t k = 0;                                                                                     \
+                for (; k + ops::width <= n; k += ops::width) {                                                         \
+                    typename ops::reg q[Q];                                                                            \
+                    _Pragma("GCC unroll 2")                                                                            \
+                    for (std::size_t j = 0; j < Q; ++j) {                                                              \
+                        q[j] = ops::load(queries + j * query_stride + k);                                              \
+                    }                                                                                                  \
+                    _Pragma("GCC unroll 8")                                                                            \
+                    for (std::size_t i = 0; i < R; ++i) {                                                              \
+                        const auto r = ops::load(rows + i * row_stride + k);                                           \
+                        for (std::size_t j = 0; j < Q; ++j) {                                                          \
+                            acc[i][j] = ops::fmadd(r, q[j], acc[i][j]);                                                \
+                        }                                                                                              \
+                    }                                                                                                  \
+                }                                                                                                      \
+                                                                                                                       \
+                for (std::size_t i = 0; i < R; ++i) {                                                                  \
+                    for (std::size_t j = 0; j < Q; ++j) {                                                              \
+                        out[j * num_rows + i] += scalar_dot(rows + i * row_stride + k, queries + j * query_stride + k, \
+                                                            n - k, ops::hsum(acc[i][j]));                              \
+                    }                                                                                                  \
+                }                                                                                                      \
+            }                                                                                                          \
+        };
+
+        SIMD_FOR_EACH_ISA(INNER_PROD_TILE_KERNEL)
+
+#undef INNER_PROD_TILE_KERNEL
+
+#endif
+
+        // R-row tiles over the rows of a row block, leftover rows one at a time
+        template<typename Tiles, std::size_t R, std::size_t Q, typename Value>
+        auto row_tiles(
+            const Value *rows, std::size_t row_stride, std::size_t block_rows,
+            const Value *queries, std::size_t query_stride, std::size_t n,
+            Value *out, std::size_t num_rows
+        ) -> void {
+            std::size_t r = 0;
+            for (; r + R <= block_rows; r += R) {
+                Tiles::template tile<R, Q>(rows + r * row_stride, row_stride, queries, query_stride, n, out + r, num_rows);
+            }
+            for (; r < block_rows; ++r) {
+                Tiles::template tile<1, Q>(rows + r * row_stride, row_stride, queries, query_stride, n, out + r, num_rows);
+            }
+        }
+
+        template<typename Tiles, typename Value>
+        auto batched_dot(
+            const Value *rows, std::size_t num_rows, const Value *queries, std::size_t num_queries, std::size_t dim,
+            Value *out
+        ) -> void {
+            constexpr auto cols = BATCH_COLS_BYTES / sizeof(Value);
+            const auto num_blocks = static_cast<std::ptrdiff_t>((num_rows + BATCH_ROW_BLOCK - 1) / BATCH_ROW_BLOCK);
+
+#pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t b = 0; b < num_blocks; ++b) {
+                const auto r_first = static_cast<std::size_t>(b) * BATCH_ROW_BLOCK;
+                const auto block_rows = std::min(BATCH_ROW_BLOCK, num_rows - r_first);
+                const auto block_out = out + r_first;
+                for (std::size_t q = 0; q < num_queries; ++q) {
+                    std::fill(block_out + q * num_rows, block_out + q * num_rows + block_rows, Value{});
+                }
+
+                for (std::size_t k = 0; k < dim; k += cols) {
+                    const auto n = std::min(cols, dim - k);
+                    const auto block = rows + r_first * dim + k;
+
+                    std::size_t q = 0;
+                    for (; q + BATCH_QUERIES <= num_queries; q += BATCH_QUERIES) {
+                        row_tiles<Tiles, BATCH_ROWS, BATCH_QUERIES>(
+                            block, dim, block_rows, queries + q * dim + k, dim, n, block_out + q * num_rows, num_rows
+                        );
+                    }
+                    for (; q < num_queries; ++q) {
+                        row_tiles<Tiles, BATCH_SINGLE_ROWS, 1>(
+                            block, dim, block_rows, queries + q * dim + k, dim, n, block_out + q * num_rows, num_rows
+                        );
+                    }
+                }
+            }
+        }
+
+    }
+
+    // Dot products of every query with every row. rows and queries are row-major matrices with dim columns (one
+    // query is a range of dim elements, a matrix-vector product), d_first receives num_queries x num_rows results
+    // row-major by query: d_first[q * num_rows + r] = dot(query q, row r). Register tiles share every loaded
+    // chunk between several rows and queries, row blocks run in parallel. dim must be positive and divide the
+    // lengths of both ranges (asserted)
+    template<std::contiguous_iterator ContIt1, std::contiguous_iterator ContIt2, std::contiguous_iterator DContIt>
+    requires std::floating_point<std::iter_value_t<ContIt1>> &&
+             std::same_as<std::iter_value_t<ContIt1>, std::iter_value_t<ContIt2>> &&
+             std::same_as<std::iter_value_t<ContIt1>, std::iter_value_t<DContIt>>
+    auto batched(
+        ContIt1 rows_first, ContIt1 rows_last,
+        ContIt2 queries_first, ContIt2 queries_last,
+        std::size_t dim,
+        DContIt d_first,
+        simd::Isa isa = simd::detect_isa()
+    ) -> DContIt {
+        const auto rows_len = static_cast<std::size_t>(std::distance(rows_first, rows_last));
+        const auto queries_len = static_cast<std::size_t>(std::distance(queries_first, queries_last));
+        assert(dim > 0 && rows_len % dim == 0 && queries_len % dim == 0);
+        const auto num_rows = rows_len / dim;
+        const auto num_queries = queries_len / dim;
+        const auto rows = std::to_address(rows_first);
+        const auto queries = std::to_address(queries_first);
+        const auto out = std::to_address(d_first);
+
+        switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+            case simd::Isa::avx512:
+                detail::batched_dot<detail::Avx512Tiles>(rows, num_rows, queries, num_queries, dim, out);
+                break;
+            case simd::Isa::avx2:
+                detail::batched_dot<detail::Avx2Tiles>(rows, num_rows, queries, num_queries, dim, out);
+                break;
+            case simd::Isa::sse2:
+                detail::batched_dot<detail::Sse2Tiles>(rows, num_rows, queries, num_queries, dim, out);
+                break;
+#endif
+            default:
+                detail::batched_dot<detail::ScalarTiles>(rows, num_rows, queries, num_queries, dim, out);
+        }
+        return d_first + static_cast<std::iter_difference_t<DContIt>>(num_rows * num_queries);
+    }
+
+}
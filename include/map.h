@@ -1,7 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <omp.h>
+
+#include "simd.h"
+#include "simd_math.h"
 
 namespace map {
 
@@ -32,4 +49,203 @@ namespace map {
         return d_first + n;
     }
 
+    // an OpenMP loop schedule, chunk 0 is the default chunk of the kind
+    struct Schedule {
+        omp_sched_t kind = omp_sched_guided;
+        int chunk = 0;
+
+        friend auto operator==(const Schedule &, const Schedule &) -> bool = default;
+    };
+
+    // openmp_alg with an explicit schedule instead of guided
+    template<
+        std::random_access_iterator RandomIt,
+        std::random_access_iterator DRandomIt,
+        typename UnaryOp
+    >
+    auto openmp_alg(RandomIt first, RandomIt last, DRandomIt d_first, UnaryOp op, Schedule schedule) -> DRandomIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        omp_sched_t prev_kind;
+        int prev_chunk;
+        omp_get_schedule(&prev_kind, &prev_chunk);
+        omp_set_schedule(schedule.kind, schedule.chunk);
+#pragma omp parallel for simd schedule(runtime)
+        for (std::size_t i = 0; i < n; ++i) {
+            d_first[i] = std::invoke(op, first[i]);
+        }
+        omp_set_schedule(prev_kind, prev_chunk);
+        return d_first + n;
+    }
+
+    namespace detail {
+
+        // timings shorter than this are mostly clock overhead
+        inline constexpr std::chrono::nanoseconds MIN_SAMPLE_TIME{10'000};
+        // a chunk should cost this much so that handing it out is noise
+        inline constexpr double TARGET_CHUNK_NS = 20'000;
+        inline constexpr std::size_t MAX_SAMPLE_BLOCKS = 64;
+        // the serial calibration prefix takes at most this fraction of the input
+        inline constexpr std::size_t SAMPLE_FRACTION = 8;
+        // coefficient of variation of the block costs below which blocks are interchangeable,
+        // and above which a chunk's cost is too unpredictable for guided's shrinking chunks
+        inline constexpr double STATIC_MAX_CV = 0.2;
+        inline constexpr double GUIDED_MAX_CV = 0.5;
+
+        // functors of one type are assumed to cost the same, plain function pointers are told apart by address
+        struct ScheduleKey {
+            std::type_index type;
+            const void *fn;
+            int size_bucket;
+
+            friend auto operator==(const ScheduleKey &, const ScheduleKey &) -> bool = default;
+        };
+
+        struct ScheduleKeyHash {
+            auto operator()(const ScheduleKey &key) const noexcept -> std::size_t {
+                const auto h = key.type.hash_code() ^ std::hash<const void *>{}(key.fn) * 31;
+                return h ^ static_cast<std::size_t>(key.size_bucket) * 0x9e3779b97f4a7c15ull;
+            }
+        };
+
+        class ScheduleCache {
+        public:
+            auto find(const ScheduleKey &key) const -> std::optional<Schedule> {
+                std::shared_lock lock(mutex_);
+                const auto it = schedules_.find(key);
+                return it == std::cend(schedules_) ? std::nullopt : std::optional(it->second);
+            }
+
+            auto insert(const ScheduleKey &key, Schedule schedule) -> void {
+                std::lock_guard lock(mutex_);
+                schedules_.insert_or_assign(key, schedule);
+            }
+
+            auto clear() -> void {
+                std::lock_guard lock(mutex_);
+                schedules_.clear();
+            }
+
+        private:
+            mutable std::shared_mutex mutex_;
+            std::unordered_map<ScheduleKey, Schedule, ScheduleKeyHash> schedules_;
+        };
+
+        inline auto schedule_cache() -> ScheduleCache & {
+            static ScheduleCache cache;
+            return cache;
+        }
+
+        template<typename UnaryOp>
+        auto schedule_key(UnaryOp op, std::size_t n) -> ScheduleKey {
+            const void *fn = nullptr;
+            if constexpr (std::is_pointer_v<UnaryOp>) {
+                fn = reinterpret_cast<const void *>(op);
+            }
+            return {typeid(UnaryOp), fn, static_cast<int>(std::bit_width(n))};
+        }
+
+        // Schedule from per-block costs: equal blocks go static (one contiguous range per thread), otherwise
+        // chunks worth TARGET_CHUNK_NS handed out guided while the cost spread is moderate, dynamic beyond
+        inline auto pick_schedule(const std::vector<double> &block_ns, std::size_t block_size, std::size_t n) -> Schedule {
+            const auto num_threads = static_cast<std::size_t>(omp_get_max_threads());
+            if (block_ns.size() < 2 || num_threads == 1) {
+                return {omp_sched_static, 0};
+            }
+
+            double mean = 0, m2 = 0;
+            for (const auto t: block_ns) {
+                mean += t;
+            }
+            mean /= static_cast<double>(block_ns.size());
+            for (const auto t: block_ns) {
+                m2 += (t - mean) * (t - mean);
+            }
+            const auto cv = std::sqrt(m2 / static_cast<double>(block_ns.size())) / mean;
+            if (cv < STATIC_MAX_CV) {
+                return {omp_sched_static, 0};
+            }
+
+            const auto elem_ns = mean / static_cast<double>(block_size);
+            // at least four chunks per thread, otherwise there is nothing left to balance
+            const auto max_chunk = std::max<std::size_t>(n / (num_threads * 4), 1);
+            const auto chunk = std::clamp<std::size_t>(static_cast<std::size_t>(TARGET_CHUNK_NS / elem_ns), 1, max_chunk);
+            return {cv < GUIDED_MAX_CV ? omp_sched_guided : omp_sched_dynamic, static_cast<int>(chunk)};
+        }
+
+        // Maps a prefix serially while timing it: the block doubles until one run is clearly measurable,
+        // then blocks of that size are timed one by one. Returns the schedule and how many elements are done
+        template<std::random_access_iterator RandomIt, std::random_access_iterator DRandomIt, typename UnaryOp>
+        auto calibrate_schedule(RandomIt first, DRandomIt d_first, std::size_t n, UnaryOp &op) -> std::pair<Schedule, std::size_t> {
+            const auto budget = n / SAMPLE_FRACTION;
+            const auto run_block = [&](std::size_t i_first, std::size_t i_last) {
+                const auto t_start = std::chrono::steady_clock::now();
+                for (auto i = i_first; i < i_last; ++i) {
+                    d_first[i] = std::invoke(op, first[i]);
+                }
+                return std::chrono::steady_clock::now() - t_start;
+            };
+
+            std::size_t done = 0, block_size = 1;
+            while (done + block_size <= budget) {
+                const auto t = run_block(done, done + block_size);
+                done += block_size;
+                if (t >= MIN_SAMPLE_TIME) {
+                    break;
+                }
+                block_size *= 2;
+            }
+
+            std::vector<double> block_ns;
+            while (block_ns.size() < MAX_SAMPLE_BLOCKS && done + block_size <= budget) {
+                const auto t = run_block(done, done + block_size);
+                done += block_size;
+                block_ns.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count()));
+            }
+            return {pick_schedule(block_ns, block_size, n), done};
+        }
+
+    }
+
+    // schedule adaptive_openmp_alg has settled on for this functor and input size, if any
+    template<typename UnaryOp>
+    auto cached_schedule(UnaryOp op, std::size_t n) -> std::optional<Schedule> {
+        return detail::schedule_cache().find(detail::schedule_key(op, n));
+    }
+
+    // forget all calibrated schedules
+    inline auto reset_schedule_cache() -> void {
+        detail::schedule_cache().clear();
+    }
+
+    // openmp_alg with the schedule chosen from the measured element costs: the first call for a functor and
+    // power of two size bucket maps a prefix serially to time it, later calls reuse the cached schedule
+    template<
+        std::random_access_iterator RandomIt,
+        std::random_access_iterator DRandomIt,
+        typename UnaryOp
+    >
+    auto adaptive_openmp_alg(RandomIt first, RandomIt last, DRandomIt d_first, UnaryOp op) -> DRandomIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        const auto key = detail::schedule_key(op, n);
+        if (const auto schedule = detail::schedule_cache().find(key)) {
+            return openmp_alg(first, last, d_first, op, *schedule);
+        }
+
+        const auto [schedule, done] = detail::calibrate_schedule(first, d_first, n, op);
+        detail::schedule_cache().insert(key, schedule);
+        openmp_alg(first + done, last, d_first + done, op, schedule);
+        return d_first + n;
+    }
+
+    // Contiguous map with op compiled for the vector ISA, a register of elements per step. op has to be
+    // inlineable and branch-free to vectorize, e.g. built from the simd_math kernels
+    template<std::contiguous_iterator ContIt, std::contiguous_iterator DContIt, typename UnaryOp>
+    auto simd_alg(
+        ContIt first, ContIt last, DContIt d_first, UnaryOp op, simd::Isa isa = simd::detect_isa()
+    ) -> DContIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        simd_math::transform(std::to_address(first), std::to_address(d_first), n, op, isa);
+        return d_first + n;
+    }
+
 }
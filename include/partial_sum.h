@@ -1,7 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <functional>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#include "simd.h"
+#include "thread_pool.h"
 
 namespace par_sum {
 
@@ -36,4 +46,618 @@ namespace par_sum {
         return naive_partial_sum(first, last, d_first, std::plus());
     }
 
-}
\ No newline at end of file
+    namespace detail {
+
+        template<typename Value>
+        concept SimdScanValue =
+            std::same_as<Value, float> || std::same_as<Value, double> ||
+            (std::integral<Value> && !std::same_as<Value, bool> && (sizeof(Value) == 4 || sizeof(Value) == 8));
+
+        // contiguous arrays of the same arithmetic type summed with std::plus get the vectorized kernel
+        template<typename InputIt, typename OutputIt, typename BinaryOp>
+        concept SimdScannable =
+            std::contiguous_iterator<InputIt> && std::contiguous_iterator<OutputIt> &&
+            std::same_as<std::iter_value_t<InputIt>, std::iter_value_t<OutputIt>> &&
+            SimdScanValue<std::iter_value_t<InputIt>> &&
+            (std::same_as<BinaryOp, std::plus<>> || std::same_as<BinaryOp, std::plus<std::iter_value_t<InputIt>>>);
+
+        template<typename Value>
+        auto scalar_inclusive_scan(const Value *in, std::size_t n, Value *out, Value carry) -> Value {
+            for (std::size_t i = 0; i < n; ++i) {
+                carry += in[i];
+                out[i] = carry;
+            }
+            return carry;
+        }
+
+#ifdef CPP_ALG_BENCH_X86
+
+        // Scan ops on top of the simd:: register wrappers. scan() is the in-register log-step shift-and-add,
+        // after it lane i holds x[0] + ... + x[i]; broadcast_last() splats the last lane, the carry into the next register.
+
+        template<typename Value>
+        struct ScanSse2;
+
+        template<>
+        struct ScanSse2<float> : simd::Sse2<float> {
+            SIMD_TARGET_SSE2 static auto scan(reg x) -> reg {
+                x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+                return _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+            }
+
+            SIMD_TARGET_SSE2 static auto broadcast_last(reg x) -> reg { return _mm_shuffle_ps(x, x, 0xFF); }
+        };
+
+        template<>
+        struct ScanSse2<double> : simd::Sse2<double> {
+            SIMD_TARGET_SSE2 static auto scan(reg x) -> reg {
+                return _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+            }
+
+            SIMD_TARGET_SSE2 static auto broadcast_last(reg x) -> reg { return _mm_unpackhi_pd(x, x); }
+        };
+
+        template<typename Value> requires std::integral<Value> && (sizeof(Value) == 4)
+        struct ScanSse2<Value> : simd::Sse2<Value> {
+            using typename simd::Sse2<Value>::reg;
+            using simd::Sse2<Value>::width;
+
+            SIMD_TARGET_SSE2 static auto scan(reg x) -> reg {
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+            }
+
+            SIMD_TARGET_SSE2 static auto broadcast_last(reg x) -> reg { return _mm_shuffle_epi32(x, 0xFF); }
+        };
+
+        template<typename Value> requires std::integral<Value> && (sizeof(Value) == 8)
+        struct ScanSse2<Value> : simd::Sse2<Value> {
+            using typename simd::Sse2<Value>::reg;
+            using simd::Sse2<Value>::width;
+
+            SIMD_TARGET_SSE2 static auto scan(reg x) -> reg { return _mm_add_epi64(x, _mm_slli_si128(x, 8)); }
+
+            SIMD_TARGET_SSE2 static auto broadcast_last(reg x) -> reg { return _mm_shuffle_epi32(x, 0xEE); }
+        };
+
+        // AVX2 byte shifts stay inside 128-bit lanes, so after the in-lane steps the low lane total
+        // is moved up with a permute and added to the high lane
+        template<typename Value>
+        struct ScanAvx2;
+
+        template<>
+        struct ScanAvx2<float> : simd::Avx2<float> {
+            SIMD_TARGET_AVX2 static auto scan(reg x) -> reg {
+                x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+                x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+                const auto low = _mm256_permute2f128_ps(x, x, 0x08);
+                return _mm256_add_ps(x, _mm256_shuffle_ps(low, low, 0xFF));
+            }
+
+            SIMD_TARGET_AVX2 static auto broadcast_last(reg x) -> reg {
+                return _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(7));
+            }
+        };
+
+        template<>
+        struct ScanAvx2<double> : simd::Avx2<double> {
+            SIMD_TARGET_AVX2 static auto scan(reg x) -> reg {
+                x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+                const auto low = _mm256_permute2f128_pd(x, x, 0x08);
+                return _mm256_add_pd(x, _mm256_permute_pd(low, 0xF));
+            }
+
+            SIMD_TARGET_AVX2 static auto broadcast_last(reg x) -> reg { return _mm256_permute4x64_pd(x, 0xFF); }
+        };
+
+        template<typename Value> requires std::integral<Value> && (sizeof(Value) == 4)
+        struct ScanAvx2<Value> : simd::Avx2<Value> {
+            using typename simd::Avx2<Value>::reg;
+            using simd::Avx2<Value>::width;
+
+            SIMD_TARGET_AVX2 static auto scan(reg x) -> reg {
+                x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+                x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+                const auto low = _mm256_permute2x128_si256(x, x, 0x08);
+                return _mm256_add_epi32(x, _mm256_shuffle_epi32(low, 0xFF));
+            }
+
+            SIMD_TARGET_AVX2 static auto broadcast_last(reg x) -> reg {
+                return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+            }
+        };
+
+        template<typename Value> requires std::integral<Value> && (sizeof(Value) == 8)
+        struct ScanAvx2<Value> : simd::Avx2<Value> {
+            using typename simd::Avx2<Value>::reg;
+            using simd::Avx2<Value>::width;
+
+            SIMD_TARGET_AVX2 static auto scan(reg x) -> reg {
+                x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+                const auto low = _mm256_permute2x128_si256(x, x, 0x08);
+                return _mm256_add_epi64(x, _mm256_shuffle_epi32(low, 0xEE));
+            }
+
+            SIMD_TARGET_AVX2 static auto broadcast_last(reg x) -> reg { return _mm256_permute4x64_epi64(x, 0xFF); }
+        };
+
+        // AVX-512 alignr against a zero register shifts across the whole register in one instruction
+        template<typename Value>
+        struct ScanAvx512;
+
+        template<>
+        struct ScanAvx512<float> : simd::Avx512<float> {
+            template<int K>
+            SIMD_TARGET_AVX512 static auto shift(reg x) -> reg {
+                return _mm512_castsi512_ps(
+                    _mm512_alignr_epi32(_mm512_castps_si512(x), _mm512_setzero_si512(), width - K)
+                );
+            }
+
+            SIMD_TARGET_AVX512 static auto scan(reg x) -> reg {
+                x = _mm512_add_ps(x, shift<1>(x));
+                x = _mm512_add_ps(x, shift<2>(x));
+                x = _mm512_add_ps(x, shift<4>(x));
+                return _mm512_add_ps(x, shift<8>(x));
+            }
+
+            SIMD_TARGET_AVX512 static auto broadcast_last(reg x) -> reg {
+                return _mm512_permutexvar_ps(_mm512_set1_epi32(15), x);
+            }
+        };
+
+        template<>
+        struct ScanAvx512<double> : simd::Avx512<double> {
+            template<int K>
+            SIMD_TARGET_AVX512 static auto shift(reg x) -> reg {
+                return _mm512_castsi512_pd(
+                    _mm512_alignr_epi64(_mm512_castpd_si512(x), _mm512_setzero_si512(), width - K)
+                );
+            }
+
+            SIMD_TARGET_AVX512 static auto scan(reg x) -> reg {
+                x = _mm512_add_pd(x, shift<1>(x));
+                x = _mm512_add_pd(x, shift<2>(x));
+                return _mm512_add_pd(x, shift<4>(x));
+            }
+
+            SIMD_TARGET_AVX512 static auto broadcast_last(reg x) -> reg {
+                return _mm512_permutexvar_pd(_mm512_set1_epi64(7), x);
+            }
+        };
+
+        template<typename Value> requires std::integral<Value> && (sizeof(Value) == 4)
+        struct ScanAvx512<Value> : simd::Avx512<Value> {
+            using typename simd::Avx512<Value>::reg;
+            using simd::Avx512<Value>::width;
+
+            template<int K>
+            SIMD_TARGET_AVX512 static auto shift(reg x) -> reg {
+                return _mm512_alignr_epi32(x, _mm512_setzero_si512(), width - K);
+            }
+
+            SIMD_TARGET_AVX512 static auto scan(reg x) -> reg {
+                x = _mm512_add_epi32(x, shift<1>(x));
+                x = _mm512_add_epi32(x, shift<2>(x));
+                x = _mm512_add_epi32(x, shift<4>(x));
+                return _mm512_add_epi32(x, shift<8>(x));
+            }
+
+            SIMD_TARGET_AVX512 static auto broadcast_last(reg x) -> reg {
+                return _mm512_permutexvar_epi32(_mm512_set1_epi32(15), x);
+            }
+        };
+
+        template<typename Value> requires std::integral<Value> && (sizeof(Value) == 8)
+        struct ScanAvx512<Value> : simd::Avx512<Value> {
+            using typename simd::Avx512<Value>::reg;
+            using simd::Avx512<Value>::width;
+
+            template<int K>
+            SIMD_TARGET_AVX512 static auto shift(reg x) -> reg {
+                return _mm512_alignr_epi64(x, _mm512_setzero_si512(), width - K);
+            }
+
+            SIMD_TARGET_AVX512 static auto scan(reg x) -> reg {
+                x = _mm512_add_epi64(x, shift<1>(x));
+                x = _mm512_add_epi64(x, shift<2>(x));
+                return _mm512_add_epi64(x, shift<4>(x));
+            }
+
+            SIMD_TARGET_AVX512 static auto broadcast_last(reg x) -> reg {
+                return _mm512_permutexvar_epi64(_mm512_set1_epi64(7), x);
+            }
+        };
+
+        // Only the add of the broadcast carry and the next broadcast sit on the loop-carried chain,
+        // the in-register scan of the next load is independent of it
+
+#define PARTIAL_SUM_SCAN_KERNEL(isa, target, Ops)                                                            \
+        template<typename Value>                                                                             \
+        target auto isa##_inclusive_scan(const Value *in, std::size_t n, Value *out, Value carry) -> Value { \
+            using ops = Scan##Ops<Value>;                                                                    \
+            auto v_carry = ops::set1(carry);                                                                 \
+            std::size_t i = 0;                                                                               \
+            for (; i + ops::width <= n; i += ops::width) {                                                   \
+                const auto x = ops::add(ops::scan(ops::load(in + i)), v_carry);                              \
+                ops::store(out + i, x);                                                                      \
+                v_carry = ops::broadcast_last(x);                                                            \
+            }                                                                                                \
+            return scalar_inclusive_scan(in + i, n - i, out + i, i == 0 ? carry : out[i - 1]);               \
+        }
+
+        SIMD_FOR_EACH_ISA(PARTIAL_SUM_SCAN_KERNEL)
+
+#undef PARTIAL_SUM_SCAN_KERNEL
+
+#endif
+
+        // out[i] = carry + in[0] + ... + in[i] with the requested instruction set, returns the running total
+        template<SimdScanValue Value>
+        auto simd_inclusive_scan(const Value *in, std::size_t n, Value *out, Value carry, simd::Isa isa) -> Value {
+            switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+                case simd::Isa::avx512:
+                    return avx512_inclusive_scan(in, n, out, carry);
+                case simd::Isa::avx2:
+                    return avx2_inclusive_scan(in, n, out, carry);
+                case simd::Isa::sse2:
+                    return sse2_inclusive_scan(in, n, out, carry);
+#endif
+                default:
+                    return scalar_inclusive_scan(in, n, out, carry);
+            }
+        }
+
+    }
+
+    // Serial inclusive sum. Contiguous float/double/32/64-bit integer ranges go through the vectorized kernel
+    // (log-step scan inside a register, broadcast carry between registers) with the instruction set picked
+    // at runtime, anything else falls back to naive_partial_sum. Floating point sums are reassociated
+    // within a register, so they may differ from the serial order in the last bits
+    template<
+        std::input_iterator InputIt,
+        std::output_iterator<typename std::iterator_traits<InputIt>::value_type> OutputIt
+    >
+    auto simd_partial_sum(
+        InputIt first, InputIt last, OutputIt d_first, simd::Isa isa = simd::detect_isa()
+    ) -> OutputIt {
+        if constexpr (detail::SimdScannable<InputIt, OutputIt, std::plus<>>) {
+            const auto n = static_cast<std::size_t>(std::distance(first, last));
+            if (n != 0) {
+                const auto in = std::to_address(first);
+                const auto out = std::to_address(d_first);
+                *out = *in;
+                detail::simd_inclusive_scan(in + 1, n - 1, out + 1, *in, isa);
+            }
+            return d_first + n;
+        } else {
+            return naive_partial_sum(first, last, d_first);
+        }
+    }
+
+    namespace detail {
+
+        // below this size a parallel scan is not worth the fork-join
+        inline constexpr std::size_t MIN_PAR_LEN = 10'000;
+
+        // [begin, end) of chunk c when n elements are split into num_chunks nearly equal parts
+        constexpr auto chunk_bounds(
+            std::size_t n, std::size_t num_chunks, std::size_t c
+        ) -> std::pair<std::size_t, std::size_t> {
+            return {n * c / num_chunks, n * (c + 1) / num_chunks};
+        }
+
+        // serial inclusive scan of a non-empty chunk, returns the chunk total
+        template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename BinaryOp>
+        auto inclusive_scan_chunk(
+            RandIt first, RandIt last, DRandIt d_first, BinaryOp op
+        ) -> typename std::iterator_traits<RandIt>::value_type {
+            if constexpr (SimdScannable<RandIt, DRandIt, BinaryOp>) {
+                const auto n = static_cast<std::size_t>(std::distance(first, last));
+                const auto in = std::to_address(first);
+                const auto out = std::to_address(d_first);
+                *out = *in;
+                return simd_inclusive_scan(in + 1, n - 1, out + 1, *in, simd::detect_isa());
+            } else {
+                typename std::iterator_traits<RandIt>::value_type acc = *first;
+                *d_first = acc;
+                while (++first != last) {
+                    acc = std::invoke(op, std::move(acc), *first);
+                    *++d_first = acc;
+                }
+                return acc;
+            }
+        }
+
+        // same, but every output is carry op x[0] op ... op x[i]
+        template<
+            std::random_access_iterator RandIt, std::random_access_iterator DRandIt,
+            typename Value, typename BinaryOp
+        >
+        auto inclusive_scan_chunk(RandIt first, RandIt last, DRandIt d_first, Value carry, BinaryOp op) -> Value {
+            if constexpr (
+                SimdScannable<RandIt, DRandIt, BinaryOp> && std::same_as<Value, std::iter_value_t<RandIt>>
+            ) {
+                return simd_inclusive_scan(
+                    std::to_address(first), static_cast<std::size_t>(std::distance(first, last)),
+                    std::to_address(d_first), carry, simd::detect_isa()
+                );
+            } else {
+                for (; first != last; ++first, ++d_first) {
+                    carry = std::invoke(op, std::move(carry), *first);
+                    *d_first = carry;
+                }
+                return carry;
+            }
+        }
+
+        // Three phases: local inclusive scan of every chunk (also gives the chunk totals), serial scan of the
+        // totals into carries, then every chunk but the first folds its carry in from the left (op may be
+        // non-commutative). for_each_chunk(num_chunks, f) is the backend, it must call f(c) for every chunk.
+        template<
+            std::random_access_iterator RandIt, std::random_access_iterator DRandIt,
+            typename BinaryOp, typename ForEachChunk
+        >
+        auto blocked_inclusive_scan(
+            RandIt first, RandIt last, DRandIt d_first, BinaryOp op,
+            std::size_t num_chunks, ForEachChunk for_each_chunk
+        ) -> DRandIt {
+            using value_type = typename std::iterator_traits<RandIt>::value_type;
+
+            const auto n = static_cast<std::size_t>(std::distance(first, last));
+            std::vector<value_type> carries(num_chunks);
+
+            for_each_chunk(num_chunks, [&](std::size_t c) {
+                const auto [b, e] = chunk_bounds(n, num_chunks, c);
+                carries[c] = inclusive_scan_chunk(first + b, first + e, d_first + b, op);
+            });
+
+            for (std::size_t c = 1; c < num_chunks; ++c) {
+                carries[c] = std::invoke(op, carries[c - 1], std::move(carries[c]));
+            }
+
+            for_each_chunk(num_chunks, [&](std::size_t c) {
+                if (c == 0) {
+                    return;
+                }
+                const auto [b, e] = chunk_bounds(n, num_chunks, c);
+                const auto &carry = carries[c - 1];
+                for (auto i = b; i != e; ++i) {
+                    d_first[i] = std::invoke(op, carry, std::move(d_first[i]));
+                }
+            });
+
+            return d_first + n;
+        }
+
+        // Exclusive scan has no identity to seed a local scan with, so it goes reduce-then-scan instead:
+        // chunk totals, serial scan of the totals starting from init, then a local exclusive scan per chunk.
+        // Every element is read before its output slot is written, so in-place (d_first == first) is fine.
+        template<
+            std::random_access_iterator RandIt, std::random_access_iterator DRandIt,
+            typename Value, typename BinaryOp, typename ForEachChunk
+        >
+        auto blocked_exclusive_scan(
+            RandIt first, RandIt last, DRandIt d_first, Value init, BinaryOp op,
+            std::size_t num_chunks, ForEachChunk for_each_chunk
+        ) -> DRandIt {
+            const auto n = static_cast<std::size_t>(std::distance(first, last));
+            std::vector<Value> carries(num_chunks);
+
+            for_each_chunk(num_chunks, [&](std::size_t c) {
+                const auto [b, e] = chunk_bounds(n, num_chunks, c);
+                Value acc = first[b];
+                for (auto i = b + 1; i != e; ++i) {
+                    acc = std::invoke(op, std::move(acc), first[i]);
+                }
+                carries[c] = std::move(acc);
+            });
+
+            for (std::size_t c = 0; c < num_chunks; ++c) {
+                auto total = std::exchange(carries[c], init);
+                init = std::invoke(op, std::move(init), std::move(total));
+            }
+
+            for_each_chunk(num_chunks, [&](std::size_t c) {
+                const auto [b, e] = chunk_bounds(n, num_chunks, c);
+                Value acc = carries[c];
+                for (auto i = b; i != e; ++i) {
+                    Value next = std::invoke(op, acc, first[i]);
+                    d_first[i] = std::move(acc);
+                    acc = std::move(next);
+                }
+            });
+
+            return d_first + n;
+        }
+
+        inline constexpr auto openmp_for_each_chunk = [](std::size_t num_chunks, const auto &f) {
+            if (num_chunks == 1) {
+                return f(0);
+            }
+#pragma omp parallel for schedule(static)
+            for (std::size_t c = 0; c < num_chunks; ++c) {
+                f(c);
+            }
+        };
+
+        inline constexpr auto pool_for_each_chunk = [](std::size_t num_chunks, const auto &f) {
+            if (num_chunks == 1) {
+                return f(0);
+            }
+            thread_pool::instance().parallel_for(0, num_chunks, 1, [&f](std::size_t c_first, std::size_t c_last) {
+                for (auto c = c_first; c != c_last; ++c) {
+                    f(c);
+                }
+            });
+        };
+
+        enum class TileStatus : unsigned char { invalid, aggregate, prefix };
+
+        template<typename Value>
+        struct alignas(64) TileDescriptor {
+            std::atomic<TileStatus> status{TileStatus::invalid};
+            Value aggregate{};
+            Value prefix{};
+        };
+
+        // one tile of the look-back scan stays cache-resident between its reduce and its scan
+        inline constexpr std::size_t LOOKBACK_TILE_BYTES = 64 * 1'024;
+
+        template<typename Value>
+        auto wait_tile(const TileDescriptor<Value> &tile) -> TileStatus {
+            auto status = tile.status.load(std::memory_order_acquire);
+            while (status == TileStatus::invalid) {
+                std::this_thread::yield();
+                status = tile.status.load(std::memory_order_acquire);
+            }
+            return status;
+        }
+
+        // walks back from tile t - 1, folding aggregates from the left, until some predecessor has
+        // published its inclusive prefix. Tile 0 always publishes a prefix, so this terminates
+        template<typename Value, typename BinaryOp>
+        auto look_back(const std::vector<TileDescriptor<Value>> &tiles, std::size_t t, BinaryOp op) -> Value {
+            auto j = t - 1;
+            if (wait_tile(tiles[j]) == TileStatus::prefix) {
+                return tiles[j].prefix;
+            }
+            Value acc = tiles[j].aggregate;
+            while (true) {
+                --j;
+                if (wait_tile(tiles[j]) == TileStatus::prefix) {
+                    return std::invoke(op, tiles[j].prefix, std::move(acc));
+                }
+                acc = std::invoke(op, tiles[j].aggregate, std::move(acc));
+            }
+        }
+
+        inline auto num_scan_chunks(std::size_t n, std::size_t concurrency) -> std::size_t {
+            return std::max<std::size_t>(1, std::min(concurrency, n / MIN_PAR_LEN));
+        }
+
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename BinaryOp>
+    auto openmp_inclusive_scan(RandIt first, RandIt last, DRandIt d_first, BinaryOp op) -> DRandIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n < detail::MIN_PAR_LEN) {
+            return naive_partial_sum(first, last, d_first, op);
+        }
+        const auto num_chunks = detail::num_scan_chunks(n, omp_get_max_threads());
+        return detail::blocked_inclusive_scan(first, last, d_first, op, num_chunks, detail::openmp_for_each_chunk);
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt>
+    auto openmp_inclusive_scan(RandIt first, RandIt last, DRandIt d_first) -> DRandIt {
+        return openmp_inclusive_scan(first, last, d_first, std::plus());
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename Value, typename BinaryOp>
+    auto openmp_exclusive_scan(RandIt first, RandIt last, DRandIt d_first, Value init, BinaryOp op) -> DRandIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n == 0) {
+            return d_first;
+        }
+        const auto num_chunks = detail::num_scan_chunks(n, omp_get_max_threads());
+        return detail::blocked_exclusive_scan(
+            first, last, d_first, std::move(init), op, num_chunks, detail::openmp_for_each_chunk
+        );
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename Value>
+    auto openmp_exclusive_scan(RandIt first, RandIt last, DRandIt d_first, Value init) -> DRandIt {
+        return openmp_exclusive_scan(first, last, d_first, std::move(init), std::plus());
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename BinaryOp>
+    auto pool_inclusive_scan(RandIt first, RandIt last, DRandIt d_first, BinaryOp op) -> DRandIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n < detail::MIN_PAR_LEN) {
+            return naive_partial_sum(first, last, d_first, op);
+        }
+        const auto num_chunks = detail::num_scan_chunks(n, thread_pool::instance().concurrency());
+        return detail::blocked_inclusive_scan(first, last, d_first, op, num_chunks, detail::pool_for_each_chunk);
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt>
+    auto pool_inclusive_scan(RandIt first, RandIt last, DRandIt d_first) -> DRandIt {
+        return pool_inclusive_scan(first, last, d_first, std::plus());
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename Value, typename BinaryOp>
+    auto pool_exclusive_scan(RandIt first, RandIt last, DRandIt d_first, Value init, BinaryOp op) -> DRandIt {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n == 0) {
+            return d_first;
+        }
+        const auto num_chunks = detail::num_scan_chunks(n, thread_pool::instance().concurrency());
+        return detail::blocked_exclusive_scan(
+            first, last, d_first, std::move(init), op, num_chunks, detail::pool_for_each_chunk
+        );
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename Value>
+    auto pool_exclusive_scan(RandIt first, RandIt last, DRandIt d_first, Value init) -> DRandIt {
+        return pool_exclusive_scan(first, last, d_first, std::move(init), std::plus());
+    }
+
+    // Single-pass decoupled look-back scan (Merrill & Garland). Tiles are claimed in order from an atomic counter,
+    // so every predecessor of a tile is already owned by a running thread and the look-back can't deadlock.
+    // A tile reduces itself (the only read from memory), publishes its aggregate, looks back for its exclusive
+    // prefix, publishes its inclusive prefix and then scans itself again from cache: one read and one write per element
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename BinaryOp>
+    auto decoupled_inclusive_scan(RandIt first, RandIt last, DRandIt d_first, BinaryOp op) -> DRandIt {
+        using value_type = typename std::iterator_traits<RandIt>::value_type;
+
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n < detail::MIN_PAR_LEN) {
+            return naive_partial_sum(first, last, d_first, op);
+        }
+
+        const auto tile_size = std::max<std::size_t>(1, detail::LOOKBACK_TILE_BYTES / sizeof(value_type));
+        const auto num_tiles = (n + tile_size - 1) / tile_size;
+
+        std::vector<detail::TileDescriptor<value_type>> tiles(num_tiles);
+        std::atomic<std::size_t> next_tile{0};
+
+        const auto scan_tiles = [&](std::size_t, std::size_t) {
+            for (auto t = next_tile.fetch_add(1); t < num_tiles; t = next_tile.fetch_add(1)) {
+                const auto b = t * tile_size;
+                const auto e = std::min(n, b + tile_size);
+                auto &tile = tiles[t];
+
+                if (t == 0) {
+                    tile.prefix = detail::inclusive_scan_chunk(first, first + e, d_first, op);
+                    tile.status.store(detail::TileStatus::prefix, std::memory_order_release);
+                    continue;
+                }
+
+                value_type aggregate = first[b];
+                for (auto i = b + 1; i != e; ++i) {
+                    aggregate = std::invoke(op, std::move(aggregate), first[i]);
+                }
+                tile.aggregate = aggregate;
+                tile.status.store(detail::TileStatus::aggregate, std::memory_order_release);
+
+                auto exclusive = detail::look_back(tiles, t, op);
+                tile.prefix = std::invoke(op, exclusive, std::move(aggregate));
+                tile.status.store(detail::TileStatus::prefix, std::memory_order_release);
+
+                detail::inclusive_scan_chunk(first + b, first + e, d_first + b, std::move(exclusive), op);
+            }
+        };
+
+        auto &pool = thread_pool::instance();
+        pool.parallel_for(0, std::min(pool.concurrency(), num_tiles), 1, scan_tiles);
+
+        return d_first + n;
+    }
+
+    template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt>
+    auto decoupled_inclusive_scan(RandIt first, RandIt last, DRandIt d_first) -> DRandIt {
+        return decoupled_inclusive_scan(first, last, d_first, std::plus());
+    }
+
+}
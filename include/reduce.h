@@ -1,9 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <concepts>
 #include <iterator>
+#include <type_traits>
 #include <execution>
 #include <future>
+#include <vector>
+
+#include <omp.h>
+
+#include "simd.h"
+#include "thread_pool.h"
 
 namespace reduce {
 
@@ -37,6 +45,28 @@ namespace reduce {
         return acc_openmp_alg(first, last, typename std::iterator_traits<InputIt>::value_type{});
     }
 
+    // Generic op version: every thread folds its static (contiguous, in thread order) chunk into a private partial
+    // starting from identity, the partials are then folded left to right into init. So op only has to be
+    // associative, and Value can be any copyable type (no omp reduction clause, which only knows built-in ops)
+    template<std::random_access_iterator RandIt, typename Value, typename BinaryOp>
+    auto acc_openmp_alg(RandIt first, RandIt last, Value init, BinaryOp op, Value identity) -> Value {
+        const auto size = std::distance(first, last);
+        std::vector<Value> partials(omp_get_max_threads(), identity);
+
+#pragma omp parallel
+        {
+            Value partial = identity;
+#pragma omp for schedule(static) nowait
+            for (std::ptrdiff_t i = 0; i < size; ++i) {
+                partial = std::invoke(op, std::move(partial), first[i]);
+            }
+            partials[omp_get_thread_num()] = std::move(partial);
+        }
+
+        return acc_loop_alg(std::make_move_iterator(partials.begin()), std::make_move_iterator(partials.end()),
+                            std::move(init), op);
+    }
+
     template<std::forward_iterator ForwardIt, typename Value>
     auto naive_reduce_thread(ForwardIt first, ForwardIt last, Value init) -> Value {
         static constexpr std::size_t MIN_LEN = 100;
@@ -126,4 +156,623 @@ namespace reduce {
         return naive_reduce_async(first, last, typename std::iterator_traits<ForwardIt>::value_type{});
     }
 
+    // same block split as naive_reduce_thread, but blocks run on the persistent thread_pool::instance()
+    // instead of freshly spawned threads. Each block is seeded with its own first element, so op needs no identity
+    template<std::random_access_iterator RandIt, typename Value, typename BinaryOp>
+    auto pool_reduce(RandIt first, RandIt last, Value init, BinaryOp op) -> Value {
+        static constexpr std::size_t MIN_LEN = 100;
+        const auto length = static_cast<std::size_t>(std::distance(first, last));
+
+        if (length <= MIN_LEN) {
+            return acc_loop_alg(first, last, std::move(init), op);
+        }
+
+        auto &pool = thread_pool::instance();
+        const auto num_blocks = std::min(pool.concurrency(), length / MIN_LEN);
+        const auto block_size = length / num_blocks;
+
+        std::vector<Value> results(num_blocks);
+
+        pool.parallel_for(0, num_blocks, 1, [&](std::size_t b_first, std::size_t b_last) {
+            for (auto b = b_first; b != b_last; ++b) {
+                const auto block_first = first + b * block_size;
+                const auto block_last = b == num_blocks - 1 ? last : block_first + block_size;
+                results[b] = acc_loop_alg(std::next(block_first), block_last, Value(*block_first), op);
+            }
+        });
+
+        return acc_loop_alg(std::cbegin(results), std::cend(results), std::move(init), op);
+    }
+
+    template<std::random_access_iterator RandIt, typename Value>
+    auto pool_reduce(RandIt first, RandIt last, Value init) -> Value {
+        return pool_reduce(first, last, init, std::plus());
+    }
+
+    template<std::random_access_iterator RandIt>
+    auto pool_reduce(RandIt first, RandIt last) -> typename std::iterator_traits<RandIt>::value_type {
+        return pool_reduce(first, last, typename std::iterator_traits<RandIt>::value_type{});
+    }
+
+    namespace detail {
+
+        // independent vector accumulators, enough to cover add latency times the number of add ports
+        inline constexpr std::size_t SIMD_ACCUMULATORS = 8;
+
+        // Value is the accumulator, Storage the element type that is widened to it (the same type for simd_alg)
+        template<typename Value, typename Storage>
+        auto scalar_sum(const Storage *p, std::size_t n, Value init) -> Value {
+            for (std::size_t i = 0; i < n; ++i) {
+                init += static_cast<Value>(p[i]);
+            }
+            return init;
+        }
+
+        template<typename Ops, typename Storage>
+        concept sum_kernel = requires(const Storage *p, typename Ops::reg r) {
+            Ops::hsum(Ops::add(r, Ops::load(p)));
+        };
+
+#ifdef CPP_ALG_BENCH_X86
+
+#define REDUCE_SUM_KERNEL(isa, target, Ops)                                       \
+        template<typename Value, typename Storage>                                \
+        target auto isa##_sum(const Storage *p, std::size_t n) -> Value {         \
+            using ops = simd::Ops<Value>;                                         \
+            constexpr auto step = SIMD_ACCUMULATORS * ops::width;                 \
+                                                                                  \
+            typename ops::reg acc[SIMD_ACCUMULATORS];                             \
+            for (auto &a: acc) {                                                  \
+                a = ops::zero();                                                  \
+            }                                                                     \
+                                                                                  \
+            std::size_t i = 0;                                                    \
+            for (; i + step <= n; i += step) {                                    \
+                _Pragma("GCC unroll 8")                                           \
+                for (std::size_t k = 0; k < SIMD_ACCUMULATORS; ++k) {             \
+                    acc[k] = ops::add(acc[k], ops::load(p + i + k * ops::width)); \
+                }                                                                 \
+            }                                                                     \
+            for (; i + ops::width <= n; i += ops::width) {                        \
+                acc[0] = ops::add(acc[0], ops::load(p + i));                      \
+            }                                                                     \
+                                                                                  \
+            for (auto w = SIMD_ACCUMULATORS / 2; w != 0; w /= 2) {                \
+                for (std::size_t k = 0; k < w; ++k) {                             \
+                    acc[k] = ops::add(acc[k], acc[k + w]);                        \
+                }                                                                 \
+            }                                                                     \
+            return scalar_sum(p + i, n - i, ops::hsum(acc[0]));                   \
+        }
+
+        SIMD_FOR_EACH_ISA(REDUCE_SUM_KERNEL)
+
+#undef REDUCE_SUM_KERNEL
+
+#endif
+
+        // an instruction set without a widening load for Storage falls through to the next narrower one
+        template<typename Value, typename Storage>
+        auto simd_sum(const Storage *p, std::size_t n, simd::Isa isa) -> Value {
+            switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+                case simd::Isa::avx512:
+                    if constexpr (sum_kernel<simd::Avx512<Value>, Storage>) {
+                        return avx512_sum<Value>(p, n);
+                    }
+                    [[fallthrough]];
+                case simd::Isa::avx2:
+                    if constexpr (sum_kernel<simd::Avx2<Value>, Storage>) {
+                        return avx2_sum<Value>(p, n);
+                    }
+                    [[fallthrough]];
+                case simd::Isa::sse2:
+                    if constexpr (sum_kernel<simd::Sse2<Value>, Storage>) {
+                        return sse2_sum<Value>(p, n);
+                    }
+                    [[fallthrough]];
+#endif
+                default:
+                    return scalar_sum(p, n, Value{});
+            }
+        }
+
+    }
+
+    // Hand-vectorized sum of a contiguous float/double range. The independent accumulators break the single
+    // dependent add chain of acc_loop_alg, which the compiler may not reassociate for floating point.
+    // The summation order differs from a serial loop, so the result may differ in the last bits
+    template<std::contiguous_iterator ContIt> requires std::floating_point<std::iter_value_t<ContIt>>
+    auto simd_alg(
+        ContIt first, ContIt last, std::iter_value_t<ContIt> init, simd::Isa isa = simd::detect_isa()
+    ) -> std::iter_value_t<ContIt> {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        return init + detail::simd_sum<std::iter_value_t<ContIt>>(std::to_address(first), n, isa);
+    }
+
+    template<std::contiguous_iterator ContIt> requires std::floating_point<std::iter_value_t<ContIt>>
+    auto simd_alg(ContIt first, ContIt last) -> std::iter_value_t<ContIt> {
+        return simd_alg(first, last, std::iter_value_t<ContIt>{});
+    }
+
+    // Mixed precision sum: the range stores a narrow type (simd::float16, simd::bfloat16, float, int8_t, int16_t,
+    // ...) and the kernels of simd_alg widen every element to the accumulator type Acc of init as it is loaded.
+    // Memory traffic is that of the storage type, rounding error and overflow range those of Acc
+    template<std::contiguous_iterator ContIt, typename Acc> requires simd::widens_to<std::iter_value_t<ContIt>, Acc>
+    auto mixed_alg(ContIt first, ContIt last, Acc init, simd::Isa isa = simd::detect_isa()) -> Acc {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        return init + detail::simd_sum<Acc>(std::to_address(first), n, isa);
+    }
+
+    // one contiguous block per thread through the mixed_alg kernels
+    template<std::contiguous_iterator ContIt, typename Acc> requires simd::widens_to<std::iter_value_t<ContIt>, Acc>
+    auto mixed_openmp_alg(ContIt first, ContIt last, Acc init, simd::Isa isa = simd::detect_isa()) -> Acc {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        const auto p = std::to_address(first);
+#pragma omp parallel reduction(+:init)
+        {
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+            const auto tid = static_cast<std::size_t>(omp_get_thread_num());
+            const auto b_first = n * tid / num_threads;
+            const auto b_last = n * (tid + 1) / num_threads;
+            init += detail::simd_sum<Acc>(p + b_first, b_last - b_first, isa);
+        }
+        return init;
+    }
+
+    namespace detail {
+
+        // The shape of the deterministic reduce depends only on the input length: fixed-size blocks, a fixed
+        // lane-interleaved sum inside a block and a fixed pairwise tree over the block sums. Threads only decide
+        // who computes which block, so the result is bitwise identical for any thread count or schedule
+        inline constexpr std::size_t DETERMINISTIC_BLOCK = 4'096;
+        inline constexpr std::size_t DETERMINISTIC_LANES = 8;
+
+        template<std::random_access_iterator RandIt, typename Value>
+        auto deterministic_block_sum(RandIt first, std::size_t n) -> Value {
+            Value lanes[DETERMINISTIC_LANES]{};
+            std::size_t i = 0;
+            for (; i + DETERMINISTIC_LANES <= n; i += DETERMINISTIC_LANES) {
+                for (std::size_t k = 0; k < DETERMINISTIC_LANES; ++k) {
+                    lanes[k] += first[i + k];
+                }
+            }
+            for (; i < n; ++i) {
+                lanes[0] += first[i];
+            }
+            for (auto w = DETERMINISTIC_LANES / 2; w != 0; w /= 2) {
+                for (std::size_t k = 0; k < w; ++k) {
+                    lanes[k] += lanes[k + w];
+                }
+            }
+            return lanes[0];
+        }
+
+        // n > 0
+        template<typename Value>
+        auto pairwise_sum(const Value *p, std::size_t n) -> Value {
+            if (n == 1) {
+                return p[0];
+            }
+            const auto half = n / 2;
+            return pairwise_sum(p, half) + pairwise_sum(p + half, n - half);
+        }
+
+        template<std::random_access_iterator RandIt, typename Value, typename ForEachBlock>
+        auto deterministic_reduce(RandIt first, RandIt last, Value init, ForEachBlock for_each_block) -> Value {
+            const auto n = static_cast<std::size_t>(std::distance(first, last));
+            if (n == 0) {
+                return init;
+            }
+
+            const auto num_blocks = (n + DETERMINISTIC_BLOCK - 1) / DETERMINISTIC_BLOCK;
+            std::vector<Value> sums(num_blocks);
+
+            for_each_block(num_blocks, [&](std::size_t b) {
+                const auto offset = b * DETERMINISTIC_BLOCK;
+                sums[b] = deterministic_block_sum<RandIt, Value>(first + offset, std::min(DETERMINISTIC_BLOCK, n - offset));
+            });
+
+            return init + pairwise_sum(sums.data(), num_blocks);
+        }
+
+    }
+
+    template<std::random_access_iterator RandIt, typename Value>
+    auto deterministic_alg(RandIt first, RandIt last, Value init) -> Value {
+        return detail::deterministic_reduce(first, last, init, [](std::size_t num_blocks, const auto &f) {
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                f(b);
+            }
+        });
+    }
+
+    // bitwise identical to deterministic_alg for any OMP_NUM_THREADS
+    template<std::random_access_iterator RandIt, typename Value>
+    auto deterministic_openmp_alg(RandIt first, RandIt last, Value init) -> Value {
+        return detail::deterministic_reduce(first, last, init, [](std::size_t num_blocks, const auto &f) {
+#pragma omp parallel for schedule(guided)
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                f(b);
+            }
+        });
+    }
+
+    template<std::random_access_iterator RandIt>
+    auto deterministic_openmp_alg(RandIt first, RandIt last) -> typename std::iterator_traits<RandIt>::value_type {
+        return deterministic_openmp_alg(first, last, typename std::iterator_traits<RandIt>::value_type{});
+    }
+
+    // bitwise identical to deterministic_alg for any pool size
+    template<std::random_access_iterator RandIt, typename Value>
+    auto deterministic_pool_alg(
+        RandIt first, RandIt last, Value init, thread_pool::ThreadPool &pool = thread_pool::instance()
+    ) -> Value {
+        return detail::deterministic_reduce(first, last, init, [&pool](std::size_t num_blocks, const auto &f) {
+            pool.parallel_for(0, num_blocks, 4, [&f](std::size_t b_first, std::size_t b_last) {
+                for (auto b = b_first; b != b_last; ++b) {
+                    f(b);
+                }
+            });
+        });
+    }
+
+    template<std::random_access_iterator RandIt>
+    auto deterministic_pool_alg(RandIt first, RandIt last) -> typename std::iterator_traits<RandIt>::value_type {
+        return deterministic_pool_alg(first, last, typename std::iterator_traits<RandIt>::value_type{});
+    }
+
+    // Statistics selectable for stats(), combine with |. Dependencies are added implicitly:
+    // argmin needs min, argmax needs max and variance needs mean
+    namespace stat {
+
+        enum Flag : unsigned {
+            sum = 1u << 0,
+            min = 1u << 1,
+            max = 1u << 2,
+            argmin = 1u << 3,
+            argmax = 1u << 4,
+            mean = 1u << 5,
+            variance = 1u << 6,
+            all = sum | min | max | argmin | argmax | mean | variance,
+        };
+
+    }
+
+    // Result of stats(), only the requested fields are meaningful. argmin/argmax are the offsets of the first
+    // minimum/maximum like std::min_element/std::max_element. m2 is the sum of squared deviations from the mean
+    template<typename Value>
+    struct Stats {
+        using real_type = std::conditional_t<std::floating_point<Value>, Value, double>;
+
+        std::size_t count = 0;
+        Value sum{};
+        Value min{};
+        Value max{};
+        std::size_t argmin = 0;
+        std::size_t argmax = 0;
+        real_type mean{};
+        real_type m2{};
+
+        [[nodiscard]] auto variance() const -> real_type {
+            return count == 0 ? real_type{} : m2 / static_cast<real_type>(count);
+        }
+
+        [[nodiscard]] auto sample_variance() const -> real_type {
+            return count < 2 ? real_type{} : m2 / static_cast<real_type>(count - 1);
+        }
+    };
+
+    namespace detail {
+
+        // Every statistic is computed block by block in one sweep over memory: a block is small enough to stay in
+        // L1, so the second pass for the squared deviations around the block mean is cheap and avoids the
+        // per-element division of Welford's update. Blocks are then combined with Chan's pairwise merge
+        inline constexpr std::size_t STATS_BLOCK = 2'048;
+        inline constexpr std::size_t STATS_ACCUMULATORS = 4;
+
+        constexpr auto stats_closure(unsigned flags) -> unsigned {
+            if ((flags & stat::argmin) != 0) {
+                flags |= stat::min;
+            }
+            if ((flags & stat::argmax) != 0) {
+                flags |= stat::max;
+            }
+            if ((flags & stat::variance) != 0) {
+                flags |= stat::mean;
+            }
+            return flags;
+        }
+
+        // lhs covers the elements right before rhs, ties keep the lhs position
+        template<unsigned Flags, typename Value>
+        auto merge_stats(Stats<Value> &lhs, const Stats<Value> &rhs) -> void {
+            using real_type = typename Stats<Value>::real_type;
+
+            if (rhs.count == 0) {
+                return;
+            }
+            if (lhs.count == 0) {
+                lhs = rhs;
+                return;
+            }
+
+            const auto n = lhs.count + rhs.count;
+            if constexpr ((Flags & stat::sum) != 0) {
+                lhs.sum += rhs.sum;
+            }
+            if constexpr ((Flags & stat::min) != 0) {
+                if (rhs.min < lhs.min) {
+                    lhs.min = rhs.min;
+                    lhs.argmin = rhs.argmin;
+                }
+            }
+            if constexpr ((Flags & stat::max) != 0) {
+                if (lhs.max < rhs.max) {
+                    lhs.max = rhs.max;
+                    lhs.argmax = rhs.argmax;
+                }
+            }
+            if constexpr ((Flags & stat::mean) != 0) {
+                const auto delta = rhs.mean - lhs.mean;
+                const auto rhs_weight = static_cast<real_type>(rhs.count) / static_cast<real_type>(n);
+                if constexpr ((Flags & stat::variance) != 0) {
+                    lhs.m2 += rhs.m2 + delta * delta * static_cast<real_type>(lhs.count) * rhs_weight;
+                }
+                lhs.mean += delta * rhs_weight;
+            }
+            lhs.count = n;
+        }
+
+        // n > 0, argmin/argmax are relative to first
+        template<unsigned Flags, std::random_access_iterator RandIt>
+        auto scalar_block_stats(RandIt first, std::size_t n) -> Stats<std::iter_value_t<RandIt>> {
+            using Value = std::iter_value_t<RandIt>;
+            using real_type = typename Stats<Value>::real_type;
+
+            Stats<Value> s;
+            s.count = n;
+            s.min = s.max = first[0];
+            real_type total{};
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto &x = first[i];
+                if constexpr ((Flags & stat::sum) != 0 || (std::floating_point<Value> && (Flags & stat::mean) != 0)) {
+                    s.sum += x;
+                }
+                if constexpr (!std::floating_point<Value> && (Flags & stat::mean) != 0) {
+                    total += static_cast<real_type>(x);
+                }
+                if constexpr ((Flags & stat::min) != 0) {
+                    if (x < s.min) {
+                        s.min = x;
+                        s.argmin = i;
+                    }
+                }
+                if constexpr ((Flags & stat::max) != 0) {
+                    if (s.max < x) {
+                        s.max = x;
+                        s.argmax = i;
+                    }
+                }
+            }
+
+            if constexpr ((Flags & stat::mean) != 0) {
+                if constexpr (std::floating_point<Value>) {
+                    total = s.sum;
+                }
+                s.mean = total / static_cast<real_type>(n);
+            }
+            if constexpr ((Flags & stat::variance) != 0) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto d = static_cast<real_type>(first[i]) - s.mean;
+                    s.m2 += d * d;
+                }
+            }
+            return s;
+        }
+
+#ifdef CPP_ALG_BENCH_X86
+
+#define REDUCE_MOMENTS_KERNEL(isa, target, Ops)                                                        \
+        template<unsigned Flags, std::floating_point Value>                                            \
+        target auto isa##_block_moments(const Value *p, std::size_t n) -> Stats<Value> {               \
+            using ops = simd::Ops<Value>;                                                              \
+            constexpr auto step = STATS_ACCUMULATORS * ops::width;                                     \
+                                                                                                       \
+            typename ops::reg sum[STATS_ACCUMULATORS], lo[STATS_ACCUMULATORS], hi[STATS_ACCUMULATORS]; \
+            for (std::size_t k = 0; k < STATS_ACCUMULATORS; ++k) {                                     \
+                sum[k] = ops::zero();                                                                  \
+                lo[k] = hi[k] = ops::set1(p[0]);                                                       \
+            }                                                                                          \
+                                                                                                       \
+            std::size_t i = 0;                                                                         \
+            for (; i + step <= n; i += step) {                                                         \
+                _Pragma("GCC unroll 4")                                                                \
+                for (std::size_t k = 0; k < STATS_ACCUMULATORS; ++k) {                                 \
+                    const auto x = ops::load(p + i + k * ops::width);                                  \
+                    if constexpr ((Flags & (stat::sum | stat::mean)) != 0) {                           \
+                        sum[k] = ops::add(sum[k], x);                                                  \
+                    }                                                                                  \
+                    if constexpr ((Flags & stat::min) != 0) {                                          \
+                        lo[k] = ops::min(lo[k], x);                                                    \
+                    }                                                                                  \
+                    if constexpr ((Flags & stat::max) != 0) {                                          \
+                        hi[k] = ops::max(hi[k], x);                                                    \
+                    }                                                                                  \
+                }                                                                                      \
+            }                                                                                          \
+            for (std::size_t k = 1; k < STATS_ACCUMULATORS; ++k) {                                     \
+                sum[0] = ops::add(sum[0], sum[k]);                                                     \
+                lo[0] = ops::min(lo[0], lo[k]);                                                        \
+                hi[0] = ops::max(hi[0], hi[k]);                                                        \
+            }                                                                                          \
+                                                                                                       \
+            Stats<Value> s;                                                                            \
+            s.count = n;                                                                               \
+            s.sum = ops::hsum(sum[0]);                                                                 \
+            s.min = ops::hmin(lo[0]);                                                                  \
+            s.max = ops::hmax(hi[0]);                                                                  \
+            for (; i < n; ++i) {                                                                       \
+                s.sum += p[i];                                                                         \
+                s.min = std::min(s.min, p[i]);                                                         \
+                s.max = std::max(s.max, p[i]);                                                         \
+            }                                                                                          \
+                                                                                                       \
+            if constexpr ((Flags & stat::mean) != 0) {                                                 \
+                s.mean = s.sum / static_cast<Value>(n);                                                \
+            }                                                                                          \
+            if constexpr ((Flags & stat::variance) != 0) {                                             \
+                const auto mean = ops::set1(s.mean);                                                   \
+                for (auto &a: sum) {                                                                   \
+                    a = ops::zero();                                                                   \
+                }                                                                                      \
+                for (i = 0; i + step <= n; i += step) {                                                \
+                    _Pragma("GCC unroll 4")                                                            \
+                    for (std::size_t k = 0; k < STATS_ACCUMULATORS; ++k) {                             \
+                        const auto d = ops::sub(ops::load(p + i + k * ops::width), mean);              \
+                        sum[k] = ops::fmadd(d, d, sum[k]);                                             \
+                    }                                                                                  \
+                }                                                                                      \
+                for (std::size_t k = 1; k < STATS_ACCUMULATORS; ++k) {                                 \
+                    sum[0] = ops::add(sum[0], sum[k]);                                                 \
+                }                                                                                      \
+                s.m2 = ops::hsum(sum[0]);                                                              \
+                for (; i < n; ++i) {                                                                   \
+                    const auto d = p[i] - s.mean;                                                      \
+                    s.m2 += d * d;                                                                     \
+                }                                                                                      \
+            }                                                                                          \
+            return s;                                                                                  \
+        }
+
+        SIMD_FOR_EACH_ISA(REDUCE_MOMENTS_KERNEL)
+
+#undef REDUCE_MOMENTS_KERNEL
+
+#endif
+
+        // n > 0, argmin/argmax are relative to p. The vector kernels only track the extrema, their first position
+        // is searched in the (still cached) block only when the block beats what running has seen so far
+        template<unsigned Flags, std::floating_point Value>
+        auto simd_block_stats(const Value *p, std::size_t n, simd::Isa isa, const Stats<Value> &running) -> Stats<Value> {
+            Stats<Value> s;
+            switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+                case simd::Isa::avx512:
+                    s = avx512_block_moments<Flags>(p, n);
+                    break;
+                case simd::Isa::avx2:
+                    s = avx2_block_moments<Flags>(p, n);
+                    break;
+                case simd::Isa::sse2:
+                    s = sse2_block_moments<Flags>(p, n);
+                    break;
+#endif
+                default:
+                    return scalar_block_stats<Flags>(p, n);
+            }
+
+            if constexpr ((Flags & stat::argmin) != 0) {
+                if (running.count == 0 || s.min < running.min) {
+                    s.argmin = static_cast<std::size_t>(std::find(p, p + n, s.min) - p);
+                }
+            }
+            if constexpr ((Flags & stat::argmax) != 0) {
+                if (running.count == 0 || running.max < s.max) {
+                    s.argmax = static_cast<std::size_t>(std::find(p, p + n, s.max) - p);
+                }
+            }
+            return s;
+        }
+
+        template<unsigned Flags, std::random_access_iterator RandIt>
+        auto range_stats(RandIt first, std::size_t begin, std::size_t end, simd::Isa isa) -> Stats<std::iter_value_t<RandIt>> {
+            using Value = std::iter_value_t<RandIt>;
+
+            Stats<Value> result;
+            for (auto b = begin; b < end; b += STATS_BLOCK) {
+                const auto len = std::min(STATS_BLOCK, end - b);
+                Stats<Value> block;
+                if constexpr (std::contiguous_iterator<RandIt> && std::floating_point<Value>) {
+                    block = simd_block_stats<Flags>(std::to_address(first) + b, len, isa, result);
+                } else {
+                    block = scalar_block_stats<Flags>(first + static_cast<std::iter_difference_t<RandIt>>(b), len);
+                }
+                block.argmin += b;
+                block.argmax += b;
+                merge_stats<Flags>(result, block);
+            }
+            return result;
+        }
+
+    }
+
+    // Fused single-pass statistics: every requested field in one sweep instead of a pass per std algorithm,
+    // e.g. stats<stat::min | stat::variance>(first, last). Input without NaNs is assumed
+    template<unsigned Flags = stat::all, std::random_access_iterator RandIt>
+    auto stats(RandIt first, RandIt last) -> Stats<std::iter_value_t<RandIt>> {
+        constexpr auto flags = detail::stats_closure(Flags);
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        return detail::range_stats<flags>(first, 0, n, simd::Isa::scalar);
+    }
+
+    template<unsigned Flags = stat::all, std::contiguous_iterator ContIt>
+        requires std::floating_point<std::iter_value_t<ContIt>>
+    auto simd_stats(ContIt first, ContIt last, simd::Isa isa = simd::detect_isa()) -> Stats<std::iter_value_t<ContIt>> {
+        constexpr auto flags = detail::stats_closure(Flags);
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        return detail::range_stats<flags>(first, 0, n, isa);
+    }
+
+    // one contiguous chunk per thread (vectorized for contiguous float/double), partials merged in chunk order
+    template<unsigned Flags = stat::all, std::random_access_iterator RandIt>
+    auto openmp_stats(RandIt first, RandIt last) -> Stats<std::iter_value_t<RandIt>> {
+        using Value = std::iter_value_t<RandIt>;
+        constexpr auto flags = detail::stats_closure(Flags);
+
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        const auto isa = simd::detect_isa();
+        std::vector<Stats<Value>> partials(static_cast<std::size_t>(omp_get_max_threads()));
+
+#pragma omp parallel
+        {
+            const auto t = static_cast<std::size_t>(omp_get_thread_num());
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+            partials[t] = detail::range_stats<flags>(first, n * t / num_threads, n * (t + 1) / num_threads, isa);
+        }
+
+        Stats<Value> result;
+        for (const auto &partial: partials) {
+            detail::merge_stats<flags>(result, partial);
+        }
+        return result;
+    }
+
+    template<unsigned Flags = stat::all, std::random_access_iterator RandIt>
+    auto pool_stats(
+        RandIt first, RandIt last, thread_pool::ThreadPool &pool = thread_pool::instance()
+    ) -> Stats<std::iter_value_t<RandIt>> {
+        using Value = std::iter_value_t<RandIt>;
+        constexpr auto flags = detail::stats_closure(Flags);
+
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        const auto isa = simd::detect_isa();
+        const auto num_chunks = std::max<std::size_t>(
+            std::min(pool.concurrency(), (n + detail::STATS_BLOCK - 1) / detail::STATS_BLOCK), 1
+        );
+        std::vector<Stats<Value>> partials(num_chunks);
+
+        pool.parallel_for(0, num_chunks, 1, [&](std::size_t c_first, std::size_t c_last) {
+            for (auto c = c_first; c != c_last; ++c) {
+                partials[c] = detail::range_stats<flags>(first, n * c / num_chunks, n * (c + 1) / num_chunks, isa);
+            }
+        });
+
+        Stats<Value> result;
+        for (const auto &partial: partials) {
+            detail::merge_stats<flags>(result, partial);
+        }
+        return result;
+    }
+
 }
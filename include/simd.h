@@ -0,0 +1,629 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPP_ALG_BENCH_X86 1
+#include <immintrin.h>
+#endif
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// kernels are compiled per instruction set with function attributes and picked at runtime,
+// so the project itself doesn't need -march flags. f16c (half precision conversions) ships with every
+// avx2 and avx512 cpu, but avx512f doesn't imply it
+#define SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f,f16c")))
+
+// The target attribute has to be on the kernel itself: a generic body inlined into an attributed wrapper is
+// compiled for the default target first and rejects the wider intrinsics. So a kernel is written once as a macro
+// KERNEL(isa, target, Ops) and defined for every instruction set by SIMD_FOR_EACH_ISA, which passes the name
+// prefix (sse2_...), the target attribute and the op struct suffix (simd::Sse2, ScanSse2, Sse2Tiles, ...)
+#define SIMD_FOR_EACH_ISA(KERNEL)               \
+    KERNEL(sse2, SIMD_TARGET_SSE2, Sse2)        \
+    KERNEL(avx2, SIMD_TARGET_AVX2, Avx2)        \
+    KERNEL(avx512, SIMD_TARGET_AVX512, Avx512)
+
+namespace simd {
+
+    // instruction sets the hand-written kernels are compiled for, ordered by width (avx2 implies fma and f16c)
+    enum class Isa { scalar, sse2, avx2, avx512 };
+
+    // widest supported instruction set, detected once via CPUID
+    inline auto detect_isa() -> Isa {
+        static const Isa isa = [] {
+#ifdef CPP_ALG_BENCH_X86
+            __builtin_cpu_init();
+            const auto f16c = __builtin_cpu_supports("f16c");
+            if (__builtin_cpu_supports("avx512f") && f16c) {
+                return Isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && f16c) {
+                return Isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return Isa::sse2;
+            }
+#endif
+            return Isa::scalar;
+        }();
+        return isa;
+    }
+
+    inline auto is_supported(Isa isa) -> bool {
+        return isa <= detect_isa();
+    }
+
+    constexpr auto isa_name(Isa isa) -> const char * {
+        switch (isa) {
+            case Isa::sse2:
+                return "sse2";
+            case Isa::avx2:
+                return "avx2";
+            case Isa::avx512:
+                return "avx512";
+            default:
+                return "scalar";
+        }
+    }
+
+    // IEEE half precision storage type, arithmetic on it is done in float
+    using float16 = _Float16;
+
+    // bfloat16 storage type: the upper half of a float (same exponent range, 8 bit mantissa), so widening is
+    // a 16 bit shift. Narrowing rounds to nearest even
+    struct bfloat16 {
+        std::uint16_t bits;
+
+        bfloat16() = default;
+
+        explicit bfloat16(float value) {
+            const auto u = std::bit_cast<std::uint32_t>(value);
+            if ((u & 0x7FFF'FFFF) > 0x7F80'0000) {
+                // keep NaN a quiet NaN instead of rounding it to infinity
+                bits = static_cast<std::uint16_t>((u >> 16) | 0x40);
+            } else {
+                bits = static_cast<std::uint16_t>((u + 0x7FFF + ((u >> 16) & 1)) >> 16);
+            }
+        }
+
+        operator float() const {
+            return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+        }
+    };
+
+    // Storage and accumulator pairs of the mixed precision kernels: float16, bfloat16 and float widen to float or
+    // double, signed integers of up to 32 bits widen to int32 or int64
+    template<typename Storage, typename Acc>
+    concept widens_to = sizeof(Storage) <= sizeof(Acc) && (
+        ((std::same_as<Acc, float> || std::same_as<Acc, double>) &&
+         (std::same_as<Storage, float16> || std::same_as<Storage, bfloat16> || std::floating_point<Storage>)) ||
+        (std::signed_integral<Acc> && sizeof(Acc) >= 4 && std::signed_integral<Storage> && sizeof(Storage) <= 4)
+    );
+
+#ifdef CPP_ALG_BENCH_X86
+
+    // Thin per-ISA register wrappers shared by the kernels. Every member carries the target attribute of its
+    // instruction set, so it only inlines into kernels compiled for the same (or a wider) set.
+    // Floating point types get arithmetic and a horizontal sum, integers only what the kernels need so far.
+    // The load overloads taking a narrower storage type read width elements and widen them to the lane type.
+
+    template<typename Value>
+    struct Sse2;
+
+    template<>
+    struct Sse2<float> {
+        using reg = __m128;
+        static constexpr std::size_t width = 4;
+
+        SIMD_TARGET_SSE2 static auto zero() -> reg { return _mm_setzero_ps(); }
+
+        SIMD_TARGET_SSE2 static auto load(const float *p) -> reg { return _mm_loadu_ps(p); }
+
+        SIMD_TARGET_SSE2 static auto load(const bfloat16 *p) -> reg {
+            const auto h = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+            return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), h));
+        }
+
+        SIMD_TARGET_SSE2 static auto store(float *p, reg x) -> void { _mm_storeu_ps(p, x); }
+
+        SIMD_TARGET_SSE2 static auto set1(float v) -> reg { return _mm_set1_ps(v); }
+
+        SIMD_TARGET_SSE2 static auto add(reg a, reg b) -> reg { return _mm_add_ps(a, b); }
+
+        SIMD_TARGET_SSE2 static auto mul(reg a, reg b) -> reg { return _mm_mul_ps(a, b); }
+
+        // a * b + c, no fused instruction before AVX2
+        SIMD_TARGET_SSE2 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+        SIMD_TARGET_SSE2 static auto hsum(reg x) -> float {
+            x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+            x = _mm_add_ss(x, _mm_shuffle_ps(x, x, 0x55));
+            return _mm_cvtss_f32(x);
+        }
+
+        SIMD_TARGET_SSE2 static auto sub(reg a, reg b) -> reg { return _mm_sub_ps(a, b); }
+
+        SIMD_TARGET_SSE2 static auto min(reg a, reg b) -> reg { return _mm_min_ps(a, b); }
+
+        SIMD_TARGET_SSE2 static auto max(reg a, reg b) -> reg { return _mm_max_ps(a, b); }
+
+        SIMD_TARGET_SSE2 static auto hmin(reg x) -> float {
+            x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+            return _mm_cvtss_f32(_mm_min_ss(x, _mm_shuffle_ps(x, x, 0x55)));
+        }
+
+        SIMD_TARGET_SSE2 static auto hmax(reg x) -> float {
+            x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+            return _mm_cvtss_f32(_mm_max_ss(x, _mm_shuffle_ps(x, x, 0x55)));
+        }
+    };
+
+    template<>
+    struct Sse2<double> {
+        using reg = __m128d;
+        static constexpr std::size_t width = 2;
+
+        SIMD_TARGET_SSE2 static auto zero() -> reg { return _mm_setzero_pd(); }
+
+        SIMD_TARGET_SSE2 static auto load(const double *p) -> reg { return _mm_loadu_pd(p); }
+
+        SIMD_TARGET_SSE2 static auto load(const float *p) -> reg {
+            return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+        }
+
+        SIMD_TARGET_SSE2 static auto load(const bfloat16 *p) -> reg {
+            return _mm_cvtps_pd(_mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadu_si32(p))));
+        }
+
+        SIMD_TARGET_SSE2 static auto store(double *p, reg x) -> void { _mm_storeu_pd(p, x); }
+
+        SIMD_TARGET_SSE2 static auto set1(double v) -> reg { return _mm_set1_pd(v); }
+
+        SIMD_TARGET_SSE2 static auto add(reg a, reg b) -> reg { return _mm_add_pd(a, b); }
+
+        SIMD_TARGET_SSE2 static auto mul(reg a, reg b) -> reg { return _mm_mul_pd(a, b); }
+
+        SIMD_TARGET_SSE2 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+        SIMD_TARGET_SSE2 static auto hsum(reg x) -> double { return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x))); }
+
+        SIMD_TARGET_SSE2 static auto sub(reg a, reg b) -> reg { return _mm_sub_pd(a, b); }
+
+        SIMD_TARGET_SSE2 static auto min(reg a, reg b) -> reg { return _mm_min_pd(a, b); }
+
+        SIMD_TARGET_SSE2 static auto max(reg a, reg b) -> reg { return _mm_max_pd(a, b); }
+
+        SIMD_TARGET_SSE2 static auto hmin(reg x) -> double { return _mm_cvtsd_f64(_mm_min_sd(x, _mm_unpackhi_pd(x, x))); }
+
+        SIMD_TARGET_SSE2 static auto hmax(reg x) -> double { return _mm_cvtsd_f64(_mm_max_sd(x, _mm_unpackhi_pd(x, x))); }
+    };
+
+    template<typename Value> requires std::integral<Value> && (sizeof(Value) == 4)
+    struct Sse2<Value> {
+        using reg = __m128i;
+        static constexpr std::size_t width = 4;
+
+        SIMD_TARGET_SSE2 static auto zero() -> reg { return _mm_setzero_si128(); }
+
+        SIMD_TARGET_SSE2 static auto load(const Value *p) -> reg {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        }
+
+        SIMD_TARGET_SSE2 static auto store(Value *p, reg x) -> void {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);
+        }
+
+        SIMD_TARGET_SSE2 static auto set1(Value v) -> reg { return _mm_set1_epi32(static_cast<int>(v)); }
+
+        SIMD_TARGET_SSE2 static auto add(reg a, reg b) -> reg { return _mm_add_epi32(a, b); }
+    };
+
+    template<typename Value> requires std::integral<Value> && (sizeof(Value) == 8)
+    struct Sse2<Value> {
+        using reg = __m128i;
+        static constexpr std::size_t width = 2;
+
+        SIMD_TARGET_SSE2 static auto zero() -> reg { return _mm_setzero_si128(); }
+
+        SIMD_TARGET_SSE2 static auto load(const Value *p) -> reg {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        }
+
+        SIMD_TARGET_SSE2 static auto store(Value *p, reg x) -> void {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);
+        }
+
+        SIMD_TARGET_SSE2 static auto set1(Value v) -> reg { return _mm_set1_epi64x(static_cast<long long>(v)); }
+
+        SIMD_TARGET_SSE2 static auto add(reg a, reg b) -> reg { return _mm_add_epi64(a, b); }
+    };
+
+    template<typename Value>
+    struct Avx2;
+
+    template<>
+    struct Avx2<float> {
+        using reg = __m256;
+        static constexpr std::size_t width = 8;
+
+        SIMD_TARGET_AVX2 static auto zero() -> reg { return _mm256_setzero_ps(); }
+
+        SIMD_TARGET_AVX2 static auto load(const float *p) -> reg { return _mm256_loadu_ps(p); }
+
+        SIMD_TARGET_AVX2 static auto load(const float16 *p) -> reg {
+            return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+        }
+
+        SIMD_TARGET_AVX2 static auto load(const bfloat16 *p) -> reg {
+            const auto h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            return _mm256_castsi256_ps(_mm256_slli_epi32(h, 16));
+        }
+
+        SIMD_TARGET_AVX2 static auto store(float *p, reg x) -> void { _mm256_storeu_ps(p, x); }
+
+        SIMD_TARGET_AVX2 static auto set1(float v) -> reg { return _mm256_set1_ps(v); }
+
+        SIMD_TARGET_AVX2 static auto add(reg a, reg b) -> reg { return _mm256_add_ps(a, b); }
+
+        SIMD_TARGET_AVX2 static auto mul(reg a, reg b) -> reg { return _mm256_mul_ps(a, b); }
+
+        SIMD_TARGET_AVX2 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm256_fmadd_ps(a, b, c); }
+
+        SIMD_TARGET_AVX2 static auto hsum(reg x) -> float {
+            auto h = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+            h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+            h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 0x55));
+            return _mm_cvtss_f32(h);
+        }
+
+        SIMD_TARGET_AVX2 static auto sub(reg a, reg b) -> reg { return _mm256_sub_ps(a, b); }
+
+        SIMD_TARGET_AVX2 static auto min(reg a, reg b) -> reg { return _mm256_min_ps(a, b); }
+
+        SIMD_TARGET_AVX2 static auto max(reg a, reg b) -> reg { return _mm256_max_ps(a, b); }
+
+        SIMD_TARGET_AVX2 static auto hmin(reg x) -> float {
+            return Sse2<float>::hmin(_mm_min_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1)));
+        }
+
+        SIMD_TARGET_AVX2 static auto hmax(reg x) -> float {
+            return Sse2<float>::hmax(_mm_max_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1)));
+        }
+    };
+
+    template<>
+    struct Avx2<double> {
+        using reg = __m256d;
+        static constexpr std::size_t width = 4;
+
+        SIMD_TARGET_AVX2 static auto zero() -> reg { return _mm256_setzero_pd(); }
+
+        SIMD_TARGET_AVX2 static auto load(const double *p) -> reg { return _mm256_loadu_pd(p); }
+
+        SIMD_TARGET_AVX2 static auto load(const float *p) -> reg { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+        SIMD_TARGET_AVX2 static auto load(const float16 *p) -> reg {
+            return _mm256_cvtps_pd(_mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+        }
+
+        SIMD_TARGET_AVX2 static auto load(const bfloat16 *p) -> reg {
+            const auto h = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+            return _mm256_cvtps_pd(_mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), h)));
+        }
+
+        SIMD_TARGET_AVX2 static auto store(double *p, reg x) -> void { _mm256_storeu_pd(p, x); }
+
+        SIMD_TARGET_AVX2 static auto set1(double v) -> reg { return _mm256_set1_pd(v); }
+
+        SIMD_TARGET_AVX2 static auto add(reg a, reg b) -> reg { return _mm256_add_pd(a, b); }
+
+        SIMD_TARGET_AVX2 static auto mul(reg a, reg b) -> reg { return _mm256_mul_pd(a, b); }
+
+        SIMD_TARGET_AVX2 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm256_fmadd_pd(a, b, c); }
+
+        SIMD_TARGET_AVX2 static auto hsum(reg x) -> double {
+            const auto h = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+        }
+
+        SIMD_TARGET_AVX2 static auto sub(reg a, reg b) -> reg { return _mm256_sub_pd(a, b); }
+
+        SIMD_TARGET_AVX2 static auto min(reg a, reg b) -> reg { return _mm256_min_pd(a, b); }
+
+        SIMD_TARGET_AVX2 static auto max(reg a, reg b) -> reg { return _mm256_max_pd(a, b); }
+
+        SIMD_TARGET_AVX2 static auto hmin(reg x) -> double {
+            return Sse2<double>::hmin(_mm_min_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1)));
+        }
+
+        SIMD_TARGET_AVX2 static auto hmax(reg x) -> double {
+            return Sse2<double>::hmax(_mm_max_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1)));
+        }
+    };
+
+    template<typename Value> requires std::integral<Value> && (sizeof(Value) == 4)
+    struct Avx2<Value> {
+        using reg = __m256i;
+        static constexpr std::size_t width = 8;
+
+        SIMD_TARGET_AVX2 static auto zero() -> reg { return _mm256_setzero_si256(); }
+
+        SIMD_TARGET_AVX2 static auto load(const Value *p) -> reg {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        }
+
+        SIMD_TARGET_AVX2 static auto store(Value *p, reg x) -> void {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+        }
+
+        SIMD_TARGET_AVX2 static auto set1(Value v) -> reg { return _mm256_set1_epi32(static_cast<int>(v)); }
+
+        SIMD_TARGET_AVX2 static auto add(reg a, reg b) -> reg { return _mm256_add_epi32(a, b); }
+
+        // low 32 bits of the products, exact modulo 2^32
+        SIMD_TARGET_AVX2 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+
+        SIMD_TARGET_AVX2 static auto hsum(reg x) -> Value {
+            Value lanes[width];
+            store(lanes, x);
+            std::make_unsigned_t<Value> sum = 0;
+            for (const auto lane: lanes) {
+                sum += static_cast<std::make_unsigned_t<Value>>(lane);
+            }
+            return static_cast<Value>(sum);
+        }
+
+        template<std::signed_integral Narrow> requires (sizeof(Narrow) < 4)
+        SIMD_TARGET_AVX2 static auto load(const Narrow *p) -> reg {
+            if constexpr (sizeof(Narrow) == 1) {
+                return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+            } else {
+                return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            }
+        }
+    };
+
+    template<typename Value> requires std::integral<Value> && (sizeof(Value) == 8)
+    struct Avx2<Value> {
+        using reg = __m256i;
+        static constexpr std::size_t width = 4;
+
+        SIMD_TARGET_AVX2 static auto zero() -> reg { return _mm256_setzero_si256(); }
+
+        SIMD_TARGET_AVX2 static auto load(const Value *p) -> reg {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        }
+
+        SIMD_TARGET_AVX2 static auto store(Value *p, reg x) -> void {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+        }
+
+        SIMD_TARGET_AVX2 static auto set1(Value v) -> reg { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+
+        SIMD_TARGET_AVX2 static auto add(reg a, reg b) -> reg { return _mm256_add_epi64(a, b); }
+
+        // signed products of the low 32 bits of the lanes: exact for lanes widened from 32 bit or narrower values
+        SIMD_TARGET_AVX2 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm256_add_epi64(_mm256_mul_epi32(a, b), c); }
+
+        SIMD_TARGET_AVX2 static auto hsum(reg x) -> Value {
+            Value lanes[width];
+            store(lanes, x);
+            std::make_unsigned_t<Value> sum = 0;
+            for (const auto lane: lanes) {
+                sum += static_cast<std::make_unsigned_t<Value>>(lane);
+            }
+            return static_cast<Value>(sum);
+        }
+
+        template<std::signed_integral Narrow> requires (sizeof(Narrow) < 8)
+        SIMD_TARGET_AVX2 static auto load(const Narrow *p) -> reg {
+            if constexpr (sizeof(Narrow) == 1) {
+                return _mm256_cvtepi8_epi64(_mm_loadu_si32(p));
+            } else if constexpr (sizeof(Narrow) == 2) {
+                return _mm256_cvtepi16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+            } else {
+                return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            }
+        }
+    };
+
+    template<typename Value>
+    struct Avx512;
+
+    template<>
+    struct Avx512<float> {
+        using reg = __m512;
+        static constexpr std::size_t width = 16;
+
+        SIMD_TARGET_AVX512 static auto zero() -> reg { return _mm512_setzero_ps(); }
+
+        SIMD_TARGET_AVX512 static auto load(const float *p) -> reg { return _mm512_loadu_ps(p); }
+
+        SIMD_TARGET_AVX512 static auto load(const float16 *p) -> reg {
+            return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+        }
+
+        SIMD_TARGET_AVX512 static auto load(const bfloat16 *p) -> reg {
+            const auto h = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+            return _mm512_castsi512_ps(_mm512_slli_epi32(h, 16));
+        }
+
+        SIMD_TARGET_AVX512 static auto store(float *p, reg x) -> void { _mm512_storeu_ps(p, x); }
+
+        SIMD_TARGET_AVX512 static auto set1(float v) -> reg { return _mm512_set1_ps(v); }
+
+        SIMD_TARGET_AVX512 static auto add(reg a, reg b) -> reg { return _mm512_add_ps(a, b); }
+
+        SIMD_TARGET_AVX512 static auto mul(reg a, reg b) -> reg { return _mm512_mul_ps(a, b); }
+
+        SIMD_TARGET_AVX512 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm512_fmadd_ps(a, b, c); }
+
+        // folded with shuffles rather than _mm512_reduce_add_ps, whose GCC 12 expansion trips -Wuninitialized
+        SIMD_TARGET_AVX512 static auto hsum(reg x) -> float {
+            x = _mm512_add_ps(x, _mm512_shuffle_f32x4(x, x, 0x4E));
+            x = _mm512_add_ps(x, _mm512_shuffle_f32x4(x, x, 0xB1));
+            auto h = _mm512_castps512_ps128(x);
+            h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+            h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 0x55));
+            return _mm_cvtss_f32(h);
+        }
+
+        SIMD_TARGET_AVX512 static auto sub(reg a, reg b) -> reg { return _mm512_sub_ps(a, b); }
+
+        SIMD_TARGET_AVX512 static auto min(reg a, reg b) -> reg { return _mm512_min_ps(a, b); }
+
+        SIMD_TARGET_AVX512 static auto max(reg a, reg b) -> reg { return _mm512_max_ps(a, b); }
+
+        SIMD_TARGET_AVX512 static auto hmin(reg x) -> float {
+            x = _mm512_min_ps(x, _mm512_shuffle_f32x4(x, x, 0x4E));
+            x = _mm512_min_ps(x, _mm512_shuffle_f32x4(x, x, 0xB1));
+            return Sse2<float>::hmin(_mm512_castps512_ps128(x));
+        }
+
+        SIMD_TARGET_AVX512 static auto hmax(reg x) -> float {
+            x = _mm512_max_ps(x, _mm512_shuffle_f32x4(x, x, 0x4E));
+            x = _mm512_max_ps(x, _mm512_shuffle_f32x4(x, x, 0xB1));
+            return Sse2<float>::hmax(_mm512_castps512_ps128(x));
+        }
+    };
+
+    template<>
+    struct Avx512<double> {
+        using reg = __m512d;
+        static constexpr std::size_t width = 8;
+
+        SIMD_TARGET_AVX512 static auto zero() -> reg { return _mm512_setzero_pd(); }
+
+        SIMD_TARGET_AVX512 static auto load(const double *p) -> reg { return _mm512_loadu_pd(p); }
+
+        SIMD_TARGET_AVX512 static auto load(const float *p) -> reg { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+
+        SIMD_TARGET_AVX512 static auto load(const float16 *p) -> reg {
+            return _mm512_cvtps_pd(_mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))));
+        }
+
+        SIMD_TARGET_AVX512 static auto load(const bfloat16 *p) -> reg {
+            const auto h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            return _mm512_cvtps_pd(_mm256_castsi256_ps(_mm256_slli_epi32(h, 16)));
+        }
+
+        SIMD_TARGET_AVX512 static auto store(double *p, reg x) -> void { _mm512_storeu_pd(p, x); }
+
+        SIMD_TARGET_AVX512 static auto set1(double v) -> reg { return _mm512_set1_pd(v); }
+
+        SIMD_TARGET_AVX512 static auto add(reg a, reg b) -> reg { return _mm512_add_pd(a, b); }
+
+        SIMD_TARGET_AVX512 static auto mul(reg a, reg b) -> reg { return _mm512_mul_pd(a, b); }
+
+        SIMD_TARGET_AVX512 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm512_fmadd_pd(a, b, c); }
+
+        SIMD_TARGET_AVX512 static auto hsum(reg x) -> double {
+            x = _mm512_add_pd(x, _mm512_shuffle_f64x2(x, x, 0x4E));
+            x = _mm512_add_pd(x, _mm512_shuffle_f64x2(x, x, 0xB1));
+            const auto h = _mm512_castpd512_pd128(x);
+            return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+        }
+
+        SIMD_TARGET_AVX512 static auto sub(reg a, reg b) -> reg { return _mm512_sub_pd(a, b); }
+
+        SIMD_TARGET_AVX512 static auto min(reg a, reg b) -> reg { return _mm512_min_pd(a, b); }
+
+        SIMD_TARGET_AVX512 static auto max(reg a, reg b) -> reg { return _mm512_max_pd(a, b); }
+
+        SIMD_TARGET_AVX512 static auto hmin(reg x) -> double {
+            x = _mm512_min_pd(x, _mm512_shuffle_f64x2(x, x, 0x4E));
+            x = _mm512_min_pd(x, _mm512_shuffle_f64x2(x, x, 0xB1));
+            return Sse2<double>::hmin(_mm512_castpd512_pd128(x));
+        }
+
+        SIMD_TARGET_AVX512 static auto hmax(reg x) -> double {
+            x = _mm512_max_pd(x, _mm512_shuffle_f64x2(x, x, 0x4E));
+            x = _mm512_max_pd(x, _mm512_shuffle_f64x2(x, x, 0xB1));
+            return Sse2<double>::hmax(_mm512_castpd512_pd128(x));
+        }
+    };
+
+    template<typename Value> requires std::integral<Value> && (sizeof(Value) == 4)
+    struct Avx512<Value> {
+        using reg = __m512i;
+        static constexpr std::size_t width = 16;
+
+        SIMD_TARGET_AVX512 static auto zero() -> reg { return _mm512_setzero_si512(); }
+
+        SIMD_TARGET_AVX512 static auto load(const Value *p) -> reg { return _mm512_loadu_si512(p); }
+
+        SIMD_TARGET_AVX512 static auto store(Value *p, reg x) -> void { _mm512_storeu_si512(p, x); }
+
+        SIMD_TARGET_AVX512 static auto set1(Value v) -> reg { return _mm512_set1_epi32(static_cast<int>(v)); }
+
+        SIMD_TARGET_AVX512 static auto add(reg a, reg b) -> reg { return _mm512_add_epi32(a, b); }
+
+        SIMD_TARGET_AVX512 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+
+        SIMD_TARGET_AVX512 static auto hsum(reg x) -> Value {
+            Value lanes[width];
+            store(lanes, x);
+            std::make_unsigned_t<Value> sum = 0;
+            for (const auto lane: lanes) {
+                sum += static_cast<std::make_unsigned_t<Value>>(lane);
+            }
+            return static_cast<Value>(sum);
+        }
+
+        template<std::signed_integral Narrow> requires (sizeof(Narrow) < 4)
+        SIMD_TARGET_AVX512 static auto load(const Narrow *p) -> reg {
+            if constexpr (sizeof(Narrow) == 1) {
+                return _mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            } else {
+                return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+            }
+        }
+    };
+
+    template<typename Value> requires std::integral<Value> && (sizeof(Value) == 8)
+    struct Avx512<Value> {
+        using reg = __m512i;
+        static constexpr std::size_t width = 8;
+
+        SIMD_TARGET_AVX512 static auto zero() -> reg { return _mm512_setzero_si512(); }
+
+        SIMD_TARGET_AVX512 static auto load(const Value *p) -> reg { return _mm512_loadu_si512(p); }
+
+        SIMD_TARGET_AVX512 static auto store(Value *p, reg x) -> void { _mm512_storeu_si512(p, x); }
+
+        SIMD_TARGET_AVX512 static auto set1(Value v) -> reg { return _mm512_set1_epi64(static_cast<long long>(v)); }
+
+        SIMD_TARGET_AVX512 static auto add(reg a, reg b) -> reg { return _mm512_add_epi64(a, b); }
+
+        // same precondition as Avx2<int64>::fmadd
+        SIMD_TARGET_AVX512 static auto fmadd(reg a, reg b, reg c) -> reg { return _mm512_add_epi64(_mm512_mul_epi32(a, b), c); }
+
+        SIMD_TARGET_AVX512 static auto hsum(reg x) -> Value {
+            Value lanes[width];
+            store(lanes, x);
+            std::make_unsigned_t<Value> sum = 0;
+            for (const auto lane: lanes) {
+                sum += static_cast<std::make_unsigned_t<Value>>(lane);
+            }
+            return static_cast<Value>(sum);
+        }
+
+        template<std::signed_integral Narrow> requires (sizeof(Narrow) < 8)
+        SIMD_TARGET_AVX512 static auto load(const Narrow *p) -> reg {
+            if constexpr (sizeof(Narrow) == 1) {
+                return _mm512_cvtepi8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+            } else if constexpr (sizeof(Narrow) == 2) {
+                return _mm512_cvtepi16_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            } else {
+                return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+            }
+        }
+    };
+
+#endif
+
+}
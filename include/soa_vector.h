@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace soa {
+
+    // Structure of arrays: one contiguous std::vector per field instead of one vector of structs, so an algorithm
+    // over a single field streams only that field. field<I>() exposes column I as a span that plugs into the
+    // iterator-based algorithms, e.g. map::loop_alg over field<0>() into field<1>()
+    template<typename... Fields>
+    class soa_vector {
+    public:
+        using value_type = std::tuple<Fields...>;
+
+        template<std::size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        soa_vector() = default;
+
+        explicit soa_vector(std::size_t size) {
+            resize(size);
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t {
+            return std::get<0>(columns_).size();
+        }
+
+        [[nodiscard]] auto empty() const noexcept -> bool {
+            return size() == 0;
+        }
+
+        auto resize(std::size_t size) -> void {
+            for_each_column([size](auto &column) { column.resize(size); });
+        }
+
+        auto reserve(std::size_t size) -> void {
+            for_each_column([size](auto &column) { column.reserve(size); });
+        }
+
+        auto clear() noexcept -> void {
+            for_each_column([](auto &column) { column.clear(); });
+        }
+
+        auto push_back(const Fields &... values) -> void {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (std::get<I>(columns_).push_back(values), ...);
+            }(std::index_sequence_for<Fields...>{});
+        }
+
+        // the fields of element idx gathered into a tuple
+        [[nodiscard]] auto operator[](std::size_t idx) const -> value_type {
+            return std::apply([idx](const auto &... columns) { return value_type(columns[idx]...); }, columns_);
+        }
+
+        template<std::size_t I>
+        [[nodiscard]] auto field() noexcept -> std::span<field_type<I>> {
+            return std::get<I>(columns_);
+        }
+
+        template<std::size_t I>
+        [[nodiscard]] auto field() const noexcept -> std::span<const field_type<I>> {
+            return std::get<I>(columns_);
+        }
+
+        // Sorts the elements by field Key. A struct sort moves whole records at every swap, here only
+        // (key, index) pairs are sorted and every column is then gathered once through the permutation
+        template<std::size_t Key, typename Compare = std::less<>>
+        auto sort_by(Compare comp = {}) -> void {
+            const auto &keys = std::get<Key>(columns_);
+            std::vector<std::pair<field_type<Key>, std::size_t>> order(size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                order[i] = {keys[i], i};
+            }
+            std::stable_sort(std::begin(order), std::end(order), [&comp](const auto &lhs, const auto &rhs) {
+                return std::invoke(comp, lhs.first, rhs.first);
+            });
+
+            for_each_column([&order](auto &column) {
+                std::remove_reference_t<decltype(column)> sorted(column.size());
+                for (std::size_t i = 0; i < order.size(); ++i) {
+                    sorted[i] = std::move(column[order[i].second]);
+                }
+                column = std::move(sorted);
+            });
+        }
+
+        friend auto operator==(const soa_vector &lhs, const soa_vector &rhs) -> bool {
+            return lhs.columns_ == rhs.columns_;
+        }
+
+    private:
+        template<typename F>
+        auto for_each_column(F f) -> void {
+            std::apply([&f](auto &... columns) { (f(columns), ...); }, columns_);
+        }
+
+        std::tuple<std::vector<Fields>...> columns_;
+    };
+
+}
@@ -0,0 +1,1392 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#include "simd.h"
+#include "thread_pool.h"
+
+namespace sort {
+
+    // keys a radix sort can order by their bits
+    template<typename Key>
+    concept RadixKey = (std::integral<Key> && !std::same_as<Key, bool>) ||
+                       std::same_as<Key, float> || std::same_as<Key, double>;
+
+    namespace detail {
+
+        inline constexpr std::size_t RADIX_BITS = 8;
+        inline constexpr std::size_t RADIX_BUCKETS = std::size_t{1} << RADIX_BITS;
+
+        // below this size a comparison sort beats the passes over all the buckets
+        inline constexpr std::size_t RADIX_MIN_LEN = 256;
+
+        // below this size a parallel radix sort is not worth the thread team
+        inline constexpr std::size_t RADIX_MIN_PAR_LEN = 1 << 16;
+
+        // every bucket collects a cache line of elements before it is written out, so the scatter writes whole
+        // lines to at most RADIX_BUCKETS places instead of single elements all over the destination
+        inline constexpr std::size_t RADIX_WC_BYTES = 64;
+
+        template<typename Key>
+        struct RadixBits {
+            using type = std::make_unsigned_t<Key>;
+        };
+
+        template<>
+        struct RadixBits<float> {
+            using type = std::uint32_t;
+        };
+
+        template<>
+        struct RadixBits<double> {
+            using type = std::uint64_t;
+        };
+
+        // Unsigned key of the same width whose unsigned order is the order of key. Signed integers get their sign
+        // bit flipped, floating point keys get every bit flipped when negative and only the sign bit otherwise,
+        // which is IEEE totalOrder: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN
+        template<RadixKey Key>
+        constexpr auto radix_bits(Key key) noexcept -> typename RadixBits<Key>::type {
+            using bits_type = typename RadixBits<Key>::type;
+            constexpr auto sign = static_cast<bits_type>(bits_type{1} << (8 * sizeof(bits_type) - 1));
+            if constexpr (std::floating_point<Key>) {
+                const auto bits = std::bit_cast<bits_type>(key);
+                const auto mask = static_cast<bits_type>(static_cast<bits_type>(0 - (bits >> (8 * sizeof(bits_type) - 1))) | sign);
+                return static_cast<bits_type>(bits ^ mask);
+            } else if constexpr (std::signed_integral<Key>) {
+                return static_cast<bits_type>(static_cast<bits_type>(key) ^ sign);
+            } else {
+                return key;
+            }
+        }
+
+        template<typename Value, typename Proj>
+        using radix_key_t = std::remove_cvref_t<std::invoke_result_t<Proj &, const Value &>>;
+
+        template<typename Value, typename Proj>
+        auto digit(const Value &value, Proj &proj, std::size_t shift) -> std::size_t {
+            return static_cast<std::size_t>((radix_bits(std::invoke(proj, value)) >> shift) & (RADIX_BUCKETS - 1));
+        }
+
+        using Histogram = std::array<std::size_t, RADIX_BUCKETS>;
+
+        // a digit every element shares does not move anything, so its pass is skipped
+        inline auto is_trivial_pass(const Histogram &counts, std::size_t n) -> bool {
+            return std::any_of(std::cbegin(counts), std::cend(counts), [n](std::size_t c) { return c == n; });
+        }
+
+        template<typename Value>
+        constexpr std::size_t wc_len = std::max<std::size_t>(RADIX_WC_BYTES / sizeof(Value), 1);
+
+        // Stable scatter of src[first, last) by the digit at shift: element i goes to dst[offsets[digit]++].
+        // Elements are staged per bucket in wc_buf (RADIX_BUCKETS * wc_len<Value> slots) and written a line at a time
+        template<typename Value, typename Proj>
+        auto scatter(
+            Value *src, std::size_t first, std::size_t last, Value *dst,
+            Histogram &offsets, std::size_t shift, Proj &proj, Value *wc_buf
+        ) -> void {
+            constexpr auto wc = wc_len<Value>;
+            if constexpr (wc == 1) {
+                for (auto i = first; i != last; ++i) {
+                    dst[offsets[digit(src[i], proj, shift)]++] = std::move(src[i]);
+                }
+            } else {
+                std::array<std::size_t, RADIX_BUCKETS> fill{};
+                for (auto i = first; i != last; ++i) {
+                    const auto d = digit(src[i], proj, shift);
+                    const auto line = wc_buf + d * wc;
+                    line[fill[d]] = std::move(src[i]);
+                    if (++fill[d] == wc) {
+                        std::move(line, line + wc, dst + offsets[d]);
+                        offsets[d] += wc;
+                        fill[d] = 0;
+                    }
+                }
+                for (std::size_t d = 0; d < RADIX_BUCKETS; ++d) {
+                    const auto line = wc_buf + d * wc;
+                    std::move(line, line + fill[d], dst + offsets[d]);
+                    offsets[d] += fill[d];
+                }
+            }
+        }
+
+        template<typename Value, typename Proj>
+        auto comparison_sort(Value *data, std::size_t n, Proj &proj) -> void {
+            std::stable_sort(data, data + n, [&proj](const Value &lhs, const Value &rhs) {
+                return radix_bits(std::invoke(proj, lhs)) < radix_bits(std::invoke(proj, rhs));
+            });
+        }
+
+        // one read builds the histograms of every digit, then one scatter per digit that is not trivial
+        template<typename Value, typename Proj>
+        auto radix_sort(Value *data, std::size_t n, Proj &proj) -> void {
+            constexpr auto passes = sizeof(radix_key_t<Value, Proj>) * 8 / RADIX_BITS;
+
+            std::array<Histogram, passes> counts{};
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto bits = radix_bits(std::invoke(proj, std::as_const(data[i])));
+                for (std::size_t p = 0; p < passes; ++p) {
+                    ++counts[p][static_cast<std::size_t>((bits >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1))];
+                }
+            }
+
+            std::vector<Value> buf(n), wc_buf(RADIX_BUCKETS * wc_len<Value>);
+            auto src = data, dst = buf.data();
+            for (std::size_t p = 0; p < passes; ++p) {
+                auto &offsets = counts[p];
+                if (is_trivial_pass(offsets, n)) {
+                    continue;
+                }
+                std::exclusive_scan(std::cbegin(offsets), std::cend(offsets), std::begin(offsets), std::size_t{0});
+                scatter(src, 0, n, dst, offsets, p * RADIX_BITS, proj, wc_buf.data());
+                std::swap(src, dst);
+            }
+            if (src != data) {
+                std::move(src, src + n, data);
+            }
+        }
+
+    }
+
+    // Stable LSD radix sort on 8-bit digits. proj(element) gives the key: an integer, float or double,
+    // ordered by value (floating point keys by IEEE totalOrder, so -0 sorts before +0 and NaNs go to the ends).
+    // Needs a buffer of n elements; passes whose digit is the same for every key are skipped
+    template<std::contiguous_iterator ContIt, typename Proj = std::identity>
+    requires std::movable<std::iter_value_t<ContIt>> && std::default_initializable<std::iter_value_t<ContIt>> &&
+             RadixKey<detail::radix_key_t<std::iter_value_t<ContIt>, Proj>>
+    auto radix_alg(ContIt first, ContIt last, Proj proj = {}) -> void {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        const auto data = std::to_address(first);
+        if (n < detail::RADIX_MIN_LEN) {
+            detail::comparison_sort(data, n, proj);
+            return;
+        }
+        detail::radix_sort(data, n, proj);
+    }
+
+    // Parallel radix_alg: every thread owns one contiguous block of the source. Per pass each thread builds the
+    // histogram of its block, the per-thread histograms are scanned bucket-major into the offsets where every
+    // thread writes each bucket (thread order inside a bucket keeps the sort stable), then every thread scatters
+    // its block through its write-combining buffers
+    template<std::contiguous_iterator ContIt, typename Proj = std::identity>
+    requires std::movable<std::iter_value_t<ContIt>> && std::default_initializable<std::iter_value_t<ContIt>> &&
+             RadixKey<detail::radix_key_t<std::iter_value_t<ContIt>, Proj>>
+    auto radix_openmp_alg(ContIt first, ContIt last, Proj proj = {}) -> void {
+        using value_type = std::iter_value_t<ContIt>;
+        constexpr auto passes = sizeof(detail::radix_key_t<value_type, Proj>) * 8 / detail::RADIX_BITS;
+
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        const auto data = std::to_address(first);
+        if (n < detail::RADIX_MIN_PAR_LEN) {
+            radix_alg(first, last, proj);
+            return;
+        }
+
+        struct alignas(64) ThreadHistogram {
+            detail::Histogram counts;
+        };
+
+        std::vector<value_type> buf(n);
+        std::vector<ThreadHistogram> histograms(static_cast<std::size_t>(omp_get_max_threads()));
+        auto src = data, dst = buf.data();
+        bool skip = false;
+
+#pragma omp parallel num_threads(static_cast<int>(histograms.size()))
+        {
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+            const auto tid = static_cast<std::size_t>(omp_get_thread_num());
+            const auto b_first = n * tid / num_threads;
+            const auto b_last = n * (tid + 1) / num_threads;
+            std::vector<value_type> wc_buf(detail::RADIX_BUCKETS * detail::wc_len<value_type>);
+            auto &local = histograms[tid].counts;
+
+            for (std::size_t p = 0; p < passes; ++p) {
+                const auto shift = p * detail::RADIX_BITS;
+                local.fill(0);
+                for (auto i = b_first; i != b_last; ++i) {
+                    ++local[detail::digit(src[i], proj, shift)];
+                }
+#pragma omp barrier
+#pragma omp single
+                {
+                    detail::Histogram totals{};
+                    for (std::size_t t = 0; t < num_threads; ++t) {
+                        for (std::size_t d = 0; d < detail::RADIX_BUCKETS; ++d) {
+                            totals[d] += histograms[t].counts[d];
+                        }
+                    }
+                    skip = detail::is_trivial_pass(totals, n);
+                    std::size_t offset = 0;
+                    for (std::size_t d = 0; d < detail::RADIX_BUCKETS && !skip; ++d) {
+                        for (std::size_t t = 0; t < num_threads; ++t) {
+                            offset += std::exchange(histograms[t].counts[d], offset);
+                        }
+                    }
+                }
+                if (!skip) {
+                    detail::scatter(src, b_first, b_last, dst, local, shift, proj, wc_buf.data());
+                }
+#pragma omp barrier
+#pragma omp single
+                {
+                    if (!skip) {
+                        std::swap(src, dst);
+                    }
+                }
+            }
+
+            if (src != data) {
+                std::move(src + b_first, src + b_last, data + b_first);
+            }
+        }
+    }
+
+    namespace detail {
+
+        // below this size the parallel comparison sorts hand over to std::sort / std::stable_sort
+        inline constexpr std::size_t PAR_SORT_MIN_LEN = 1 << 14;
+
+        // more buckets than threads, so the stealing in the bucket sort phase evens out unequal buckets
+        inline constexpr std::size_t SAMPLE_BUCKETS_PER_THREAD = 4;
+
+        // samples drawn per splitter, the bucket sizes concentrate around n / buckets as this grows
+        inline constexpr std::size_t SAMPLE_OVERSAMPLING = 32;
+
+        // bucket ids are stored as 16 bits per element
+        inline constexpr std::size_t SAMPLE_MAX_SPLITTERS = 32'767;
+
+        // Sorted, distinct splitters from an oversampled random sample. The generator is seeded with n,
+        // so a given input always gets the same splitters
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto sample_splitters(
+            RandIt first, std::size_t n, std::size_t num_buckets, Compare &comp
+        ) -> std::vector<std::iter_value_t<RandIt>> {
+            std::vector<std::iter_value_t<RandIt>> samples;
+            samples.reserve(num_buckets * SAMPLE_OVERSAMPLING);
+            std::minstd_rand gen(static_cast<std::minstd_rand::result_type>(n));
+            std::uniform_int_distribution<std::size_t> dis(0, n - 1);
+            for (std::size_t i = 0; i < num_buckets * SAMPLE_OVERSAMPLING; ++i) {
+                samples.push_back(first[dis(gen)]);
+            }
+            std::sort(std::begin(samples), std::end(samples), comp);
+
+            std::vector<std::iter_value_t<RandIt>> splitters;
+            splitters.reserve(num_buckets - 1);
+            for (std::size_t b = 1; b < num_buckets; ++b) {
+                const auto &s = samples[b * SAMPLE_OVERSAMPLING];
+                if (splitters.empty() || comp(splitters.back(), s)) {
+                    splitters.push_back(s);
+                }
+            }
+            return splitters;
+        }
+
+        // Bucket 2 * b holds the values strictly between splitters b - 1 and b, bucket 2 * b - 1 the values equal
+        // to splitter b - 1. Equality buckets need no sorting, so heavy duplicates can't pile up in one bucket
+        template<typename Value, typename Compare>
+        auto classify(const std::vector<Value> &splitters, const Value &value, Compare &comp) -> std::size_t {
+            const auto b = static_cast<std::size_t>(
+                std::upper_bound(std::cbegin(splitters), std::cend(splitters), value, comp) - std::cbegin(splitters)
+            );
+            return b > 0 && !comp(splitters[b - 1], value) ? 2 * b - 1 : 2 * b;
+        }
+
+        template<std::random_access_iterator RandIt>
+        using run_type = std::pair<RandIt, RandIt>;
+
+        // Split positions of sorted runs such that runs[i][0, splits[i]) over all i are the first rank elements
+        // of their stable merge (equal elements ordered by run index). Every step takes the middle of the widest
+        // open window as pivot, its exact merge rank tells on which side of the split every run lies
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto multiway_split(
+            const std::vector<run_type<RandIt>> &runs, std::size_t rank, Compare &comp
+        ) -> std::vector<std::size_t> {
+            const auto k = runs.size();
+            std::vector<std::size_t> lo(k, 0), hi(k), ranks(k);
+            for (std::size_t i = 0; i < k; ++i) {
+                hi[i] = static_cast<std::size_t>(runs[i].second - runs[i].first);
+            }
+
+            while (true) {
+                std::size_t m = 0;
+                for (std::size_t i = 1; i < k; ++i) {
+                    if (hi[i] - lo[i] > hi[m] - lo[m]) {
+                        m = i;
+                    }
+                }
+                if (hi[m] == lo[m]) {
+                    return lo;
+                }
+
+                const auto mid = lo[m] + (hi[m] - lo[m]) / 2;
+                const auto &pivot = runs[m].first[mid];
+                std::size_t total = 0;
+                for (std::size_t i = 0; i < k; ++i) {
+                    const auto [r_first, r_last] = runs[i];
+                    if (i == m) {
+                        ranks[i] = mid;
+                    } else if (i < m) {
+                        ranks[i] = static_cast<std::size_t>(std::upper_bound(r_first, r_last, pivot, comp) - r_first);
+                    } else {
+                        ranks[i] = static_cast<std::size_t>(std::lower_bound(r_first, r_last, pivot, comp) - r_first);
+                    }
+                    total += ranks[i];
+                }
+
+                if (total < rank) {
+                    for (std::size_t i = 0; i < k; ++i) {
+                        lo[i] = std::max(lo[i], ranks[i]);
+                    }
+                    lo[m] = mid + 1;
+                } else {
+                    for (std::size_t i = 0; i < k; ++i) {
+                        hi[i] = std::min(hi[i], ranks[i]);
+                    }
+                    hi[m] = mid;
+                }
+            }
+        }
+
+        // stable k-way merge: a heap of run indices whose top is the smallest head, ties go to the lower run
+        template<std::random_access_iterator RandIt, std::random_access_iterator DRandIt, typename Compare>
+        auto multiway_merge(std::vector<run_type<RandIt>> runs, DRandIt d_first, Compare &comp) -> DRandIt {
+            const auto later = [&runs, &comp](std::size_t lhs, std::size_t rhs) {
+                if (comp(*runs[rhs].first, *runs[lhs].first)) {
+                    return true;
+                }
+                return !comp(*runs[lhs].first, *runs[rhs].first) && lhs > rhs;
+            };
+
+            std::vector<std::size_t> heap;
+            for (std::size_t i = 0; i < runs.size(); ++i) {
+                if (runs[i].first != runs[i].second) {
+                    heap.push_back(i);
+                }
+            }
+            std::make_heap(std::begin(heap), std::end(heap), later);
+
+            while (heap.size() > 1) {
+                std::pop_heap(std::begin(heap), std::end(heap), later);
+                auto &run = runs[heap.back()];
+                *d_first++ = std::move(*run.first++);
+                if (run.first == run.second) {
+                    heap.pop_back();
+                } else {
+                    std::push_heap(std::begin(heap), std::end(heap), later);
+                }
+            }
+            if (!heap.empty()) {
+                d_first = std::move(runs[heap.front()].first, runs[heap.front()].second, d_first);
+            }
+            return d_first;
+        }
+
+    }
+
+    // Parallel sample sort on pool. Splitters come from an oversampled random sample, every thread classifies
+    // one block into buckets (equal-to-splitter buckets included) and counts them, the counts are scanned
+    // bucket-major into scatter offsets, the blocks are scattered into a buffer and the buckets are sorted
+    // with std::sort as stealable tasks and moved back. Not stable
+    template<std::random_access_iterator RandIt, typename Compare = std::less<>>
+    requires std::sortable<RandIt, Compare> && std::copyable<std::iter_value_t<RandIt>> &&
+             std::default_initializable<std::iter_value_t<RandIt>>
+    auto pool_sample_sort(
+        RandIt first, RandIt last, Compare comp = {}, thread_pool::ThreadPool &pool = thread_pool::instance()
+    ) -> void {
+        using value_type = std::iter_value_t<RandIt>;
+
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n < detail::PAR_SORT_MIN_LEN) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        const auto num_blocks = pool.concurrency();
+        const auto splitters = detail::sample_splitters(
+            first, n, std::min(num_blocks * detail::SAMPLE_BUCKETS_PER_THREAD, detail::SAMPLE_MAX_SPLITTERS + 1), comp
+        );
+        const auto num_buckets = 2 * splitters.size() + 1;
+
+        std::vector<std::uint16_t> bucket_of(n);
+        std::vector<std::vector<std::size_t>> offsets(num_blocks, std::vector<std::size_t>(num_buckets));
+        pool.parallel_for(0, num_blocks, 1, [&](std::size_t b_first, std::size_t b_last) {
+            for (auto b = b_first; b != b_last; ++b) {
+                auto &counts = offsets[b];
+                for (auto i = n * b / num_blocks; i != n * (b + 1) / num_blocks; ++i) {
+                    const auto c = detail::classify(splitters, first[i], comp);
+                    bucket_of[i] = static_cast<std::uint16_t>(c);
+                    ++counts[c];
+                }
+            }
+        });
+
+        std::vector<std::size_t> bucket_bounds(num_buckets + 1);
+        std::size_t offset = 0;
+        for (std::size_t c = 0; c < num_buckets; ++c) {
+            bucket_bounds[c] = offset;
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                offset += std::exchange(offsets[b][c], offset);
+            }
+        }
+        bucket_bounds[num_buckets] = n;
+
+        std::vector<value_type> buf(n);
+        pool.parallel_for(0, num_blocks, 1, [&](std::size_t b_first, std::size_t b_last) {
+            for (auto b = b_first; b != b_last; ++b) {
+                auto &block_offsets = offsets[b];
+                for (auto i = n * b / num_blocks; i != n * (b + 1) / num_blocks; ++i) {
+                    buf[block_offsets[bucket_of[i]]++] = std::move(first[i]);
+                }
+            }
+        });
+
+        pool.parallel_for(0, num_buckets, 1, [&](std::size_t c_first, std::size_t c_last) {
+            for (auto c = c_first; c != c_last; ++c) {
+                const auto b_first = std::begin(buf) + static_cast<std::ptrdiff_t>(bucket_bounds[c]);
+                const auto b_last = std::begin(buf) + static_cast<std::ptrdiff_t>(bucket_bounds[c + 1]);
+                if (c % 2 == 0) {
+                    std::sort(b_first, b_last, comp);
+                }
+                std::move(b_first, b_last, first + static_cast<std::iter_difference_t<RandIt>>(bucket_bounds[c]));
+            }
+        });
+    }
+
+    // Stable parallel merge sort on pool: one run per thread sorted with std::stable_sort, then the output is cut
+    // into equal parts by exact multiway splitting of the runs, and every part is a stable k-way merge into
+    // a buffer. Equal elements keep their input order because runs are in input order and merges prefer the lower run
+    template<std::random_access_iterator RandIt, typename Compare = std::less<>>
+    requires std::sortable<RandIt, Compare> && std::default_initializable<std::iter_value_t<RandIt>>
+    auto pool_merge_sort(
+        RandIt first, RandIt last, Compare comp = {}, thread_pool::ThreadPool &pool = thread_pool::instance()
+    ) -> void {
+        using value_type = std::iter_value_t<RandIt>;
+        using diff_type = std::iter_difference_t<RandIt>;
+
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n < detail::PAR_SORT_MIN_LEN) {
+            std::stable_sort(first, last, comp);
+            return;
+        }
+
+        const auto num_runs = pool.concurrency();
+        std::vector<detail::run_type<RandIt>> runs(num_runs);
+        for (std::size_t r = 0; r < num_runs; ++r) {
+            runs[r] = {first + static_cast<diff_type>(n * r / num_runs), first + static_cast<diff_type>(n * (r + 1) / num_runs)};
+        }
+        pool.parallel_for(0, num_runs, 1, [&](std::size_t r_first, std::size_t r_last) {
+            for (auto r = r_first; r != r_last; ++r) {
+                std::stable_sort(runs[r].first, runs[r].second, comp);
+            }
+        });
+
+        // splits[p][r]: where part p starts in run r
+        std::vector<std::vector<std::size_t>> splits(num_runs + 1);
+        splits[0].assign(num_runs, 0);
+        for (std::size_t r = 0; r < num_runs; ++r) {
+            splits[num_runs].push_back(static_cast<std::size_t>(runs[r].second - runs[r].first));
+        }
+        pool.parallel_for(1, num_runs, 1, [&](std::size_t p_first, std::size_t p_last) {
+            for (auto p = p_first; p != p_last; ++p) {
+                splits[p] = detail::multiway_split(runs, n * p / num_runs, comp);
+            }
+        });
+
+        std::vector<value_type> buf(n);
+        pool.parallel_for(0, num_runs, 1, [&](std::size_t p_first, std::size_t p_last) {
+            for (auto p = p_first; p != p_last; ++p) {
+                std::vector<detail::run_type<RandIt>> parts(num_runs);
+                for (std::size_t r = 0; r < num_runs; ++r) {
+                    parts[r] = {runs[r].first + static_cast<diff_type>(splits[p][r]),
+                                runs[r].first + static_cast<diff_type>(splits[p + 1][r])};
+                }
+                detail::multiway_merge(std::move(parts), std::begin(buf) + static_cast<std::ptrdiff_t>(n * p / num_runs), comp);
+            }
+        });
+
+        pool.parallel_for(0, num_runs, 1, [&](std::size_t p_first, std::size_t p_last) {
+            for (auto p = p_first; p != p_last; ++p) {
+                std::move(std::begin(buf) + static_cast<std::ptrdiff_t>(n * p / num_runs),
+                          std::begin(buf) + static_cast<std::ptrdiff_t>(n * (p + 1) / num_runs),
+                          first + static_cast<diff_type>(n * p / num_runs));
+            }
+        });
+    }
+
+    namespace detail {
+
+        // below this size a partition is finished by insertion sort
+        inline constexpr std::ptrdiff_t PDQ_INSERTION_SORT_THRESHOLD = 24;
+
+        // above this size the pivot is Tukey's ninther instead of the median of three
+        inline constexpr std::ptrdiff_t PDQ_NINTHER_THRESHOLD = 128;
+
+        // moves an insertion sort may make on an already partitioned range before it gives up
+        inline constexpr std::ptrdiff_t PDQ_PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+        // elements compared per block by the branchless partition, offsets fit in a byte
+        inline constexpr std::ptrdiff_t PDQ_BLOCK_SIZE = 64;
+
+        // comparisons that are cheap and unpredictable enough that the branchless partition pays off
+        template<typename Compare, typename Value>
+        constexpr bool pdq_branchless = std::is_arithmetic_v<Value> && (
+            std::same_as<Compare, std::less<>> || std::same_as<Compare, std::less<Value>> ||
+            std::same_as<Compare, std::greater<>> || std::same_as<Compare, std::greater<Value>>
+        );
+
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto insertion_sort(RandIt begin, RandIt end, Compare &comp) -> void {
+            if (begin == end) {
+                return;
+            }
+            for (auto cur = begin + 1; cur != end; ++cur) {
+                auto sift = cur, sift_1 = cur - 1;
+                if (comp(*sift, *sift_1)) {
+                    auto tmp = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*sift_1);
+                    } while (sift != begin && comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                }
+            }
+        }
+
+        // insertion sort of a range that has an element not greater than any of its own right before begin
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto unguarded_insertion_sort(RandIt begin, RandIt end, Compare &comp) -> void {
+            if (begin == end) {
+                return;
+            }
+            for (auto cur = begin + 1; cur != end; ++cur) {
+                auto sift = cur, sift_1 = cur - 1;
+                if (comp(*sift, *sift_1)) {
+                    auto tmp = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*sift_1);
+                    } while (comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                }
+            }
+        }
+
+        // insertion sort that gives up after PDQ_PARTIAL_INSERTION_SORT_LIMIT moves, returns whether it finished
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto partial_insertion_sort(RandIt begin, RandIt end, Compare &comp) -> bool {
+            if (begin == end) {
+                return true;
+            }
+            std::ptrdiff_t moves = 0;
+            for (auto cur = begin + 1; cur != end; ++cur) {
+                auto sift = cur, sift_1 = cur - 1;
+                if (comp(*sift, *sift_1)) {
+                    auto tmp = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*sift_1);
+                    } while (sift != begin && comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                    moves += cur - sift;
+                }
+                if (moves > PDQ_PARTIAL_INSERTION_SORT_LIMIT) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto sort2(RandIt a, RandIt b, Compare &comp) -> void {
+            if (comp(*b, *a)) {
+                std::iter_swap(a, b);
+            }
+        }
+
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto sort3(RandIt a, RandIt b, RandIt c, Compare &comp) -> void {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        // swaps first[offsets_l[i]] with last[-offsets_r[i]] for i < num, as one cycle of moves unless the
+        // caller asks for swaps (a cycle would break when both blocks are finished at once)
+        template<std::random_access_iterator RandIt>
+        auto swap_offsets(
+            RandIt first, RandIt last, const unsigned char *offsets_l, const unsigned char *offsets_r,
+            std::ptrdiff_t num, bool use_swaps
+        ) -> void {
+            if (use_swaps) {
+                for (std::ptrdiff_t i = 0; i < num; ++i) {
+                    std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+                }
+            } else if (num > 0) {
+                auto l = first + offsets_l[0];
+                auto r = last - offsets_r[0];
+                auto tmp = std::move(*l);
+                *l = std::move(*r);
+                for (std::ptrdiff_t i = 1; i < num; ++i) {
+                    l = first + offsets_l[i];
+                    *r = std::move(*l);
+                    r = last - offsets_r[i];
+                    *l = std::move(*r);
+                }
+                *r = std::move(tmp);
+            }
+        }
+
+        // Partitions [begin, end) around the pivot *begin into < pivot and >= pivot, returns the final pivot
+        // position and whether the range was already partitioned. BlockQuicksort: the comparisons of a block of
+        // elements on either side only write the offsets of misplaced elements (the comparison result is added to
+        // a counter, there is no branch on it), then the misplaced elements are swapped pairwise off the offsets
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto partition_right_branchless(RandIt begin, RandIt end, Compare &comp) -> std::pair<RandIt, bool> {
+            auto pivot = std::move(*begin);
+            auto first = begin, last = end;
+
+            // the median of three guarantees an element >= pivot on the right, so only the first search is guarded
+            while (comp(*++first, pivot));
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot));
+            } else {
+                while (!comp(*--last, pivot));
+            }
+
+            const bool already_partitioned = first >= last;
+            if (!already_partitioned) {
+                std::iter_swap(first, last);
+                ++first;
+
+                alignas(64) unsigned char offsets_l[PDQ_BLOCK_SIZE];
+                alignas(64) unsigned char offsets_r[PDQ_BLOCK_SIZE];
+                auto offsets_l_base = first, offsets_r_base = last;
+                std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+                while (first < last) {
+                    // fill whichever offset buffers are empty, splitting what is left between them at the end
+                    const auto num_unknown = last - first;
+                    const auto left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                    const auto right_split = num_r == 0 ? num_unknown - left_split : 0;
+
+                    if (left_split >= PDQ_BLOCK_SIZE) {
+                        for (std::ptrdiff_t i = 0; i < PDQ_BLOCK_SIZE;) {
+#pragma GCC unroll 8
+                            for (std::ptrdiff_t u = 0; u < 8; ++u) {
+                                offsets_l[num_l] = static_cast<unsigned char>(i++);
+                                num_l += !comp(*first, pivot);
+                                ++first;
+                            }
+                        }
+                    } else {
+                        for (std::ptrdiff_t i = 0; i < left_split;) {
+                            offsets_l[num_l] = static_cast<unsigned char>(i++);
+                            num_l += !comp(*first, pivot);
+                            ++first;
+                        }
+                    }
+
+                    if (right_split >= PDQ_BLOCK_SIZE) {
+                        for (std::ptrdiff_t i = 0; i < PDQ_BLOCK_SIZE;) {
+#pragma GCC unroll 8
+                            for (std::ptrdiff_t u = 0; u < 8; ++u) {
+                                offsets_r[num_r] = static_cast<unsigned char>(++i);
+                                num_r += comp(*--last, pivot);
+                            }
+                        }
+                    } else {
+                        for (std::ptrdiff_t i = 0; i < right_split;) {
+                            offsets_r[num_r] = static_cast<unsigned char>(++i);
+                            num_r += comp(*--last, pivot);
+                        }
+                    }
+
+                    const auto num = std::min(num_l, num_r);
+                    swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+                    num_l -= num;
+                    num_r -= num;
+                    start_l += num;
+                    start_r += num;
+                    if (num_l == 0) {
+                        start_l = 0;
+                        offsets_l_base = first;
+                    }
+                    if (num_r == 0) {
+                        start_r = 0;
+                        offsets_r_base = last;
+                    }
+                }
+
+                // one side may still have misplaced elements, they go to the far end of the other side
+                if (num_l > 0) {
+                    while (num_l--) {
+                        std::iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+                    }
+                    first = last;
+                }
+                if (num_r > 0) {
+                    while (num_r--) {
+                        std::iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+                        ++first;
+                    }
+                    last = first;
+                }
+            }
+
+            const auto pivot_pos = first - 1;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        // the same partition as classic Hoare crossing scans, one branch per comparison
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto partition_right(RandIt begin, RandIt end, Compare &comp) -> std::pair<RandIt, bool> {
+            auto pivot = std::move(*begin);
+            auto first = begin, last = end;
+
+            while (comp(*++first, pivot));
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot));
+            } else {
+                while (!comp(*--last, pivot));
+            }
+
+            const bool already_partitioned = first >= last;
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (comp(*++first, pivot));
+                while (!comp(*--last, pivot));
+            }
+
+            const auto pivot_pos = first - 1;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        // Partitions into <= pivot and > pivot. Used when the pivot equals the element before the range, so every
+        // element equal to it is already in place after this one partition and is never looked at again
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto partition_left(RandIt begin, RandIt end, Compare &comp) -> RandIt {
+            auto pivot = std::move(*begin);
+            auto first = begin, last = end;
+
+            while (comp(pivot, *--last));
+            if (last + 1 == end) {
+                while (first < last && !comp(pivot, *++first));
+            } else {
+                while (!comp(pivot, *++first));
+            }
+
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (comp(pivot, *--last));
+                while (!comp(pivot, *++first));
+            }
+
+            const auto pivot_pos = last;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return pivot_pos;
+        }
+
+        // breaks up the pattern around a highly unbalanced partition by swapping a few elements at quarter points
+        template<std::random_access_iterator RandIt>
+        auto break_patterns(RandIt begin, RandIt pivot_pos, RandIt end) -> void {
+            const auto l_size = pivot_pos - begin;
+            const auto r_size = end - (pivot_pos + 1);
+            if (l_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                std::iter_swap(begin, begin + l_size / 4);
+                std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > PDQ_NINTHER_THRESHOLD) {
+                    std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                std::iter_swap(end - 1, end - r_size / 4);
+                if (r_size > PDQ_NINTHER_THRESHOLD) {
+                    std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    std::iter_swap(end - 2, end - (1 + r_size / 4));
+                    std::iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        }
+
+    }
+
+    // Base case of the recursive sorts: partitions of at most max_len elements are handed to it whole as
+    // base_case(first, last, comp). This one is the insertion sort of pdq_sort
+    struct InsertionBaseCase {
+        static constexpr std::ptrdiff_t max_len = detail::PDQ_INSERTION_SORT_THRESHOLD - 1;
+
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto operator()(RandIt first, RandIt last, Compare &comp) const -> void {
+            detail::insertion_sort(first, last, comp);
+        }
+    };
+
+    namespace detail {
+
+        // Recurses into the left partition and loops on the right one. bad_allowed counts the highly unbalanced
+        // partitions left before the range is handed to heapsort, leftmost tells whether there is an element
+        // before begin that bounds the range from below
+        template<bool Branchless, std::random_access_iterator RandIt, typename Compare, typename BaseCase>
+        auto pdq_loop(
+            RandIt begin, RandIt end, Compare &comp, const BaseCase &base_case, int bad_allowed, bool leftmost
+        ) -> void {
+            while (true) {
+                const auto size = end - begin;
+                if (size <= BaseCase::max_len) {
+                    if constexpr (!std::same_as<BaseCase, InsertionBaseCase>) {
+                        base_case(begin, end, comp);
+                    } else if (leftmost) {
+                        insertion_sort(begin, end, comp);
+                    } else {
+                        unguarded_insertion_sort(begin, end, comp);
+                    }
+                    return;
+                }
+
+                // the pivot ends up in *begin
+                const auto s2 = size / 2;
+                if (size > PDQ_NINTHER_THRESHOLD) {
+                    sort3(begin, begin + s2, end - 1, comp);
+                    sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                    sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                    sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                    std::iter_swap(begin, begin + s2);
+                } else {
+                    sort3(begin + s2, begin, end - 1, comp);
+                }
+
+                // a pivot equal to the element before the range is the smallest value left in it
+                if (!leftmost && !comp(*(begin - 1), *begin)) {
+                    begin = partition_left(begin, end, comp) + 1;
+                    continue;
+                }
+
+                const auto [pivot_pos, already_partitioned] = Branchless
+                                                              ? partition_right_branchless(begin, end, comp)
+                                                              : partition_right(begin, end, comp);
+
+                const auto l_size = pivot_pos - begin;
+                const auto r_size = end - (pivot_pos + 1);
+                if (l_size < size / 8 || r_size < size / 8) {
+                    if (--bad_allowed == 0) {
+                        std::make_heap(begin, end, comp);
+                        std::sort_heap(begin, end, comp);
+                        return;
+                    }
+                    break_patterns(begin, pivot_pos, end);
+                } else if (already_partitioned && partial_insertion_sort(begin, pivot_pos, comp) &&
+                           partial_insertion_sort(pivot_pos + 1, end, comp)) {
+                    // a partition that swapped nothing hints at sorted input, cheap to confirm
+                    return;
+                }
+
+                pdq_loop<Branchless>(begin, pivot_pos, comp, base_case, bad_allowed, leftmost);
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+
+    }
+
+    // Pattern-defeating quicksort (Peters): median of three or ninther pivots, insertion sort below 24 elements,
+    // partial insertion sort on partitions that moved nothing (linear time on sorted input), a separate partition
+    // for runs of elements equal to the pivot, pattern breaking swaps after unbalanced partitions and heapsort
+    // after log2(n) of them, so O(n log n) worst case. Arithmetic values compared with std::less / std::greater use
+    // the branchless block partition, anything else the branchy one. base_case takes over the partitions of up to
+    // BaseCase::max_len elements (see InsertionBaseCase). Not stable
+    template<std::random_access_iterator RandIt, typename Compare = std::less<>, typename BaseCase = InsertionBaseCase>
+    requires std::sortable<RandIt, Compare>
+    auto pdq_sort(RandIt first, RandIt last, Compare comp = {}, BaseCase base_case = {}) -> void {
+        const auto n = std::distance(first, last);
+        if (n < 2) {
+            return;
+        }
+        constexpr bool branchless = detail::pdq_branchless<Compare, std::iter_value_t<RandIt>>;
+        detail::pdq_loop<branchless>(first, last, comp, base_case, std::bit_width(static_cast<std::size_t>(n)) - 1, true);
+    }
+
+    // pdq_sort with the branchy Hoare partition whatever the type, the baseline for the branchless partition
+    template<std::random_access_iterator RandIt, typename Compare = std::less<>>
+    requires std::sortable<RandIt, Compare>
+    auto pdq_branchy_sort(RandIt first, RandIt last, Compare comp = {}) -> void {
+        const auto n = std::distance(first, last);
+        if (n < 2) {
+            return;
+        }
+        detail::pdq_loop<false>(first, last, comp, InsertionBaseCase{}, std::bit_width(static_cast<std::size_t>(n)) - 1, true);
+    }
+
+    // pdq_sort with the branchless block partition whatever the comparator
+    template<std::random_access_iterator RandIt, typename Compare = std::less<>>
+    requires std::sortable<RandIt, Compare>
+    auto pdq_branchless_sort(RandIt first, RandIt last, Compare comp = {}) -> void {
+        const auto n = std::distance(first, last);
+        if (n < 2) {
+            return;
+        }
+        detail::pdq_loop<true>(first, last, comp, InsertionBaseCase{}, std::bit_width(static_cast<std::size_t>(n)) - 1, true);
+    }
+
+    // value types the sorting networks handle
+    template<typename Value>
+    concept NetworkSortable = std::same_as<Value, std::int32_t> || std::same_as<Value, std::int64_t> ||
+                              std::same_as<Value, float> || std::same_as<Value, double>;
+
+    namespace detail {
+
+        // longest range network_sort handles with a single network
+        inline constexpr std::size_t NETWORK_MAX_LEN = 256;
+
+        // longest partition NetworkBaseCase takes, past it the network costs more than another partition
+        inline constexpr std::ptrdiff_t NETWORK_BASE_LEN = 64;
+
+#ifdef CPP_ALG_BENCH_X86
+
+        // Lane permutations of the networks for W lanes made of Scale 32-bit parts each, so one 32-bit permute
+        // moves 64-bit lanes too. Row t < log2(W) maps lane l to l ^ 2^t, row log2(W) + t to l ^ (2^(t + 1) - 1),
+        // the last row is the reversal
+        template<std::size_t W, std::size_t Scale>
+        constexpr auto network_permutes() {
+            constexpr auto log_w = static_cast<std::size_t>(std::bit_width(W) - 1);
+            std::array<std::array<std::int32_t, W * Scale>, 2 * log_w> table{};
+            for (std::size_t t = 0; t < log_w; ++t) {
+                for (std::size_t l = 0; l < W; ++l) {
+                    for (std::size_t h = 0; h < Scale; ++h) {
+                        table[t][l * Scale + h] = static_cast<std::int32_t>((l ^ (std::size_t{1} << t)) * Scale + h);
+                        table[log_w + t][l * Scale + h] = static_cast<std::int32_t>((l ^ ((std::size_t{2} << t) - 1)) * Scale + h);
+                    }
+                }
+            }
+            return table;
+        }
+
+        // row t: all ones in the 32-bit parts of the lanes with bit t set, the lanes that take the max
+        template<std::size_t W, std::size_t Scale>
+        constexpr auto network_masks() {
+            constexpr auto log_w = static_cast<std::size_t>(std::bit_width(W) - 1);
+            std::array<std::array<std::int32_t, W * Scale>, log_w> table{};
+            for (std::size_t t = 0; t < log_w; ++t) {
+                for (std::size_t l = 0; l < W * Scale; ++l) {
+                    table[t][l] = (l / Scale >> t) & 1 ? -1 : 0;
+                }
+            }
+            return table;
+        }
+
+        // the same masks as bit masks over 32-bit parts for AVX-512 blends
+        template<std::size_t W, std::size_t Scale>
+        constexpr auto network_kmasks() {
+            constexpr auto log_w = static_cast<std::size_t>(std::bit_width(W) - 1);
+            std::array<__mmask16, log_w> table{};
+            for (std::size_t t = 0; t < log_w; ++t) {
+                for (std::size_t l = 0; l < W * Scale; ++l) {
+                    if ((l / Scale >> t) & 1) {
+                        table[t] = static_cast<__mmask16>(table[t] | (1u << l));
+                    }
+                }
+            }
+            return table;
+        }
+
+        // Compare-exchange registers of the networks, moved through integer registers for the lane permutes.
+        // Floating point min/max are a blend on b < a rather than min_ps/max_ps, which return b for both when the
+        // lanes compare equal and so would turn a -0/+0 pair into two copies of the same zero: lanes that compare
+        // equal (or unordered) pass through, and a compare-exchange only ever permutes its inputs. The in-register
+        // exchange sees the operands swapped in the partner lane, so it takes max(y, x) for the tie to stay put
+
+        template<typename Value>
+        struct NetworkAvx2;
+
+        template<>
+        struct NetworkAvx2<float> {
+            using reg = __m256;
+            static constexpr std::size_t width = 8;
+
+            SIMD_TARGET_AVX2 static auto load(const float *p) -> reg { return _mm256_loadu_ps(p); }
+
+            SIMD_TARGET_AVX2 static auto store(float *p, reg x) -> void { _mm256_storeu_ps(p, x); }
+
+            SIMD_TARGET_AVX2 static auto min(reg a, reg b) -> reg { return _mm256_blendv_ps(a, b, _mm256_cmp_ps(b, a, _CMP_LT_OQ)); }
+
+            SIMD_TARGET_AVX2 static auto max(reg a, reg b) -> reg { return _mm256_blendv_ps(b, a, _mm256_cmp_ps(b, a, _CMP_LT_OQ)); }
+
+            SIMD_TARGET_AVX2 static auto to_int(reg x) -> __m256i { return _mm256_castps_si256(x); }
+
+            SIMD_TARGET_AVX2 static auto from_int(__m256i x) -> reg { return _mm256_castsi256_ps(x); }
+        };
+
+        template<>
+        struct NetworkAvx2<double> {
+            using reg = __m256d;
+            static constexpr std::size_t width = 4;
+
+            SIMD_TARGET_AVX2 static auto load(const double *p) -> reg { return _mm256_loadu_pd(p); }
+
+            SIMD_TARGET_AVX2 static auto store(double *p, reg x) -> void { _mm256_storeu_pd(p, x); }
+
+            SIMD_TARGET_AVX2 static auto min(reg a, reg b) -> reg { return _mm256_blendv_pd(a, b, _mm256_cmp_pd(b, a, _CMP_LT_OQ)); }
+
+            SIMD_TARGET_AVX2 static auto max(reg a, reg b) -> reg { return _mm256_blendv_pd(b, a, _mm256_cmp_pd(b, a, _CMP_LT_OQ)); }
+
+            SIMD_TARGET_AVX2 static auto to_int(reg x) -> __m256i { return _mm256_castpd_si256(x); }
+
+            SIMD_TARGET_AVX2 static auto from_int(__m256i x) -> reg { return _mm256_castsi256_pd(x); }
+        };
+
+        template<>
+        struct NetworkAvx2<std::int32_t> {
+            using reg = __m256i;
+            static constexpr std::size_t width = 8;
+
+            SIMD_TARGET_AVX2 static auto load(const std::int32_t *p) -> reg {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            }
+
+            SIMD_TARGET_AVX2 static auto store(std::int32_t *p, reg x) -> void {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+            }
+
+            SIMD_TARGET_AVX2 static auto min(reg a, reg b) -> reg { return _mm256_min_epi32(a, b); }
+
+            SIMD_TARGET_AVX2 static auto max(reg a, reg b) -> reg { return _mm256_max_epi32(a, b); }
+
+            SIMD_TARGET_AVX2 static auto to_int(reg x) -> __m256i { return x; }
+
+            SIMD_TARGET_AVX2 static auto from_int(__m256i x) -> reg { return x; }
+        };
+
+        // AVX2 has no 64-bit min/max, a compare and a blend stand in
+        template<>
+        struct NetworkAvx2<std::int64_t> {
+            using reg = __m256i;
+            static constexpr std::size_t width = 4;
+
+            SIMD_TARGET_AVX2 static auto load(const std::int64_t *p) -> reg {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            }
+
+            SIMD_TARGET_AVX2 static auto store(std::int64_t *p, reg x) -> void {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+            }
+
+            SIMD_TARGET_AVX2 static auto min(reg a, reg b) -> reg { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+
+            SIMD_TARGET_AVX2 static auto max(reg a, reg b) -> reg { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+
+            SIMD_TARGET_AVX2 static auto to_int(reg x) -> __m256i { return x; }
+
+            SIMD_TARGET_AVX2 static auto from_int(__m256i x) -> reg { return x; }
+        };
+
+        template<typename Value>
+        struct NetworkAvx512;
+
+        template<>
+        struct NetworkAvx512<float> {
+            using reg = __m512;
+            static constexpr std::size_t width = 16;
+
+            SIMD_TARGET_AVX512 static auto load(const float *p) -> reg { return _mm512_loadu_ps(p); }
+
+            SIMD_TARGET_AVX512 static auto store(float *p, reg x) -> void { _mm512_storeu_ps(p, x); }
+
+            SIMD_TARGET_AVX512 static auto min(reg a, reg b) -> reg {
+                return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(b, a, _CMP_LT_OQ), a, b);
+            }
+
+            SIMD_TARGET_AVX512 static auto max(reg a, reg b) -> reg {
+                return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(b, a, _CMP_LT_OQ), b, a);
+            }
+
+            SIMD_TARGET_AVX512 static auto to_int(reg x) -> __m512i { return _mm512_castps_si512(x); }
+
+            SIMD_TARGET_AVX512 static auto from_int(__m512i x) -> reg { return _mm512_castsi512_ps(x); }
+        };
+
+        template<>
+        struct NetworkAvx512<double> {
+            using reg = __m512d;
+            static constexpr std::size_t width = 8;
+
+            SIMD_TARGET_AVX512 static auto load(const double *p) -> reg { return _mm512_loadu_pd(p); }
+
+            SIMD_TARGET_AVX512 static auto store(double *p, reg x) -> void { _mm512_storeu_pd(p, x); }
+
+            SIMD_TARGET_AVX512 static auto min(reg a, reg b) -> reg {
+                return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(b, a, _CMP_LT_OQ), a, b);
+            }
+
+            SIMD_TARGET_AVX512 static auto max(reg a, reg b) -> reg {
+                return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(b, a, _CMP_LT_OQ), b, a);
+            }
+
+            SIMD_TARGET_AVX512 static auto to_int(reg x) -> __m512i { return _mm512_castpd_si512(x); }
+
+            SIMD_TARGET_AVX512 static auto from_int(__m512i x) -> reg { return _mm512_castsi512_pd(x); }
+        };
+
+        template<>
+        struct NetworkAvx512<std::int32_t> {
+            using reg = __m512i;
+            static constexpr std::size_t width = 16;
+
+            SIMD_TARGET_AVX512 static auto load(const std::int32_t *p) -> reg { return _mm512_loadu_si512(p); }
+
+            SIMD_TARGET_AVX512 static auto store(std::int32_t *p, reg x) -> void { _mm512_storeu_si512(p, x); }
+
+            SIMD_TARGET_AVX512 static auto min(reg a, reg b) -> reg { return _mm512_min_epi32(a, b); }
+
+            SIMD_TARGET_AVX512 static auto max(reg a, reg b) -> reg { return _mm512_max_epi32(a, b); }
+
+            SIMD_TARGET_AVX512 static auto to_int(reg x) -> __m512i { return x; }
+
+            SIMD_TARGET_AVX512 static auto from_int(__m512i x) -> reg { return x; }
+        };
+
+        template<>
+        struct NetworkAvx512<std::int64_t> {
+            using reg = __m512i;
+            static constexpr std::size_t width = 8;
+
+            SIMD_TARGET_AVX512 static auto load(const std::int64_t *p) -> reg { return _mm512_loadu_si512(p); }
+
+            SIMD_TARGET_AVX512 static auto store(std::int64_t *p, reg x) -> void { _mm512_storeu_si512(p, x); }
+
+            SIMD_TARGET_AVX512 static auto min(reg a, reg b) -> reg { return _mm512_min_epi64(a, b); }
+
+            SIMD_TARGET_AVX512 static auto max(reg a, reg b) -> reg { return _mm512_max_epi64(a, b); }
+
+            SIMD_TARGET_AVX512 static auto to_int(reg x) -> __m512i { return x; }
+
+            SIMD_TARGET_AVX512 static auto from_int(__m512i x) -> reg { return x; }
+        };
+
+        // Bitonic sort of R registers (R * width elements, a power of two) in place. Stage s merges blocks of 2^s
+        // elements, every comparator of a stage puts the min at the lower index: the first step pairs i with
+        // i ^ (2^s - 1) (the block mirrored, so no descending halves are needed), the next ones i with i ^ 2^t.
+        // Pairs in different registers are a min/max of whole registers (the mirror reverses one of them),
+        // pairs inside a register a lane permute, a min/max and a blend of the lanes that take the max
+
+#define NETWORK_SORT_KERNEL(target, Ops, lane_masks)                                                               \
+            template<typename Value, std::size_t R>                                                                \
+            target static auto sort(Value *p) -> void {                                                            \
+                using ops = Network##Ops<Value>;                                                                   \
+                constexpr auto W = ops::width;                                                                     \
+                constexpr auto scale = sizeof(typename ops::reg) / sizeof(std::int32_t) / W;                       \
+                constexpr auto log_w = static_cast<std::size_t>(std::bit_width(W) - 1);                            \
+                constexpr auto log_p = static_cast<std::size_t>(std::bit_width(R * W) - 1);                        \
+                alignas(typename ops::reg) static constexpr auto permutes = network_permutes<W, scale>();          \
+                alignas(typename ops::reg) static constexpr auto masks = lane_masks<W, scale>();                   \
+                                                                                                                   \
+                typename ops::reg r[R];                                                                            \
+                _Pragma("GCC unroll 64")                                                                           \
+                for (std::size_t i = 0; i < R; ++i) {                                                              \
+                    r[i] = ops::load(p + i * W);                                                                   \
+                }                                                                                                  \
+                                                                                                                   \
+                _Pragma("GCC unroll 8")                                                                            \
+                for (std::size_t s = 1; s <= log_p; ++s) {                                                         \
+                    if (s <= log_w) {                                                                              \
+                        _Pragma("GCC unroll 64")                                                                   \
+                        for (std::size_t i = 0; i < R; ++i) {                                                      \
+                            r[i] = exchange<ops>(r[i], permute<ops>(r[i], permutes[log_w + s - 1]), masks[s - 1]); \
+                        }                                                                                          \
+                    } else {                                                                                       \
+                        const auto k = std::size_t{1} << (s - log_w);                                              \
+                        _Pragma("GCC unroll 64")                                                                   \
+                        for (std::size_t i = 0; i < R / 2; ++i) {                                                  \
+                            const auto a = i / (k / 2) * k + i % (k / 2);                                          \
+                            const auto b = i / (k / 2) * k + k - 1 - i % (k / 2);                                  \
+                            const auto rev = permute<ops>(r[b], permutes[2 * log_w - 1]);                          \
+                            r[b] = permute<ops>(ops::max(r[a], rev), permutes[2 * log_w - 1]);                     \
+                            r[a] = ops::min(r[a], rev);                                                            \
+                        }                                                                                          \
+                    }                                                                                              \
+                    _Pragma("GCC unroll 8")                                                                        \
+                    for (std::size_t u = 1; u < s; ++u) {                                                          \
+                        const auto t = s - 1 - u;                                                                  \
+                        if (t >= log_w) {                                                                          \
+                            const auto j = std::size_t{1} << (t - log_w);                                          \
+                            _Pragma("GCC unroll 64")                                                               \
+                            for (std::size_t i = 0; i < R / 2; ++i) {                                              \
+                                const auto a = i / j * 2 * j + i % j;                                              \
+                                const auto lo = ops::min(r[a], r[a + j]);                                          \
+                                r[a + j] = ops::max(r[a], r[a + j]);                                               \
+                                r[a] = lo;                                                                         \
+                            }                                                                                      \
+                        } else {                                                                                   \
+                            _Pragma("GCC unroll 64")                                                               \
+                            for (std::size_t i = 0; i < R; ++i) {                                                  \
+                                r[i] = exchange<ops>(r[i], permute<ops>(r[i], permutes[t]), masks[t]);             \
+                            }                                                                                      \
+                        }                                                                                          \
+                    }                                                                                              \
+                }                                                                                                  \
+                                                                                                                   \
+                _Pragma("GCC unroll 64")                                                                           \
+                for (std::size_t i = 0; i < R; ++i) {                                                              \
+                    ops::store(p + i * W, r[i]);                                                                   \
+                }                                                                                                  \
+            }
+
+        struct Avx2Network {
+            template<typename Value>
+            static constexpr std::size_t width = NetworkAvx2<Value>::width;
+
+            // lane l of the result is lane permutes[row][l] of x
+            template<typename Ops, typename Table>
+            SIMD_TARGET_AVX2 static auto permute(typename Ops::reg x, const Table &row) -> typename Ops::reg {
+                const auto idx = _mm256_load_si256(reinterpret_cast<const __m256i *>(row.data()));
+                return Ops::from_int(_mm256_permutevar8x32_epi32(Ops::to_int(x), idx));
+            }
+
+            // compare-exchange of every lane with its partner in y, the lanes set in mask keep the max
+            template<typename Ops, typename Table>
+            SIMD_TARGET_AVX2 static auto exchange(typename Ops::reg x, typename Ops::reg y, const Table &mask) -> typename Ops::reg {
+                const auto m = _mm256_load_si256(reinterpret_cast<const __m256i *>(mask.data()));
+                return Ops::from_int(_mm256_blendv_epi8(Ops::to_int(Ops::min(x, y)), Ops::to_int(Ops::max(y, x)), m));
+            }
+
+            NETWORK_SORT_KERNEL(SIMD_TARGET_AVX2, Avx2, network_masks)
+        };
+
+        struct Avx512Network {
+            template<typename Value>
+            static constexpr std::size_t width = NetworkAvx512<Value>::width;
+
+            // lane l of the result is lane permutes[row][l] of x
+            template<typename Ops, typename Table>
+            SIMD_TARGET_AVX512 static auto permute(typename Ops::reg x, const Table &row) -> typename Ops::reg {
+                return Ops::from_int(_mm512_permutexvar_epi32(_mm512_load_si512(row.data()), Ops::to_int(x)));
+            }
+
+            // compare-exchange of every lane with its partner in y, the lanes set in mask keep the max
+            template<typename Ops>
+            SIMD_TARGET_AVX512 static auto exchange(typename Ops::reg x, typename Ops::reg y, __mmask16 mask) -> typename Ops::reg {
+                return Ops::from_int(_mm512_mask_blend_epi32(mask, Ops::to_int(Ops::min(x, y)), Ops::to_int(Ops::max(y, x))));
+            }
+
+            NETWORK_SORT_KERNEL(SIMD_TARGET_AVX512, Avx512, network_kmasks)
+        };
+
+#undef NETWORK_SORT_KERNEL
+
+        // picks the network of R registers for regs registers
+        template<typename Network, typename Value, std::size_t R = 1>
+        auto network_dispatch(Value *p, std::size_t regs) -> void {
+            if constexpr (R * Network::template width<Value> <= NETWORK_MAX_LEN) {
+                if (regs == R) {
+                    Network::template sort<Value, R>(p);
+                } else {
+                    network_dispatch<Network, Value, 2 * R>(p, regs);
+                }
+            }
+        }
+
+        // Networks only come in powers of two of at least one register: shorter ranges are padded
+        // with the largest value into a local buffer and the first n elements copied back
+        template<typename Network, typename Value>
+        auto network_sort_padded(Value *data, std::size_t n) -> void {
+            constexpr auto W = Network::template width<Value>;
+            const auto padded = std::max(std::bit_ceil(n), W);
+            if (padded == n) {
+                network_dispatch<Network>(data, n / W);
+                return;
+            }
+
+            alignas(64) Value buf[NETWORK_MAX_LEN];
+            std::copy(data, data + n, buf);
+            std::fill(buf + n, buf + padded, std::numeric_limits<Value>::has_infinity
+                                             ? std::numeric_limits<Value>::infinity()
+                                             : std::numeric_limits<Value>::max());
+            network_dispatch<Network>(buf, padded / W);
+            std::copy(buf, buf + n, data);
+        }
+
+#endif
+
+        // sorts data[0, n) ascending, n <= NETWORK_MAX_LEN, returns false if isa has no network
+        template<NetworkSortable Value>
+        auto network_sort_short(Value *data, std::size_t n, simd::Isa isa) -> bool {
+            if (n < 2) {
+                return true;
+            }
+            switch (isa) {
+#ifdef CPP_ALG_BENCH_X86
+                case simd::Isa::avx512:
+                    network_sort_padded<Avx512Network>(data, n);
+                    return true;
+                case simd::Isa::avx2:
+                    network_sort_padded<Avx2Network>(data, n);
+                    return true;
+#endif
+                default:
+                    return false;
+            }
+        }
+
+    }
+
+    // Base case that sorts partitions of up to 64 int32, int64, float or double values compared with std::less
+    // with a sorting network, anything else with insertion sort
+    struct NetworkBaseCase {
+        static constexpr std::ptrdiff_t max_len = detail::NETWORK_BASE_LEN;
+
+        simd::Isa isa = simd::detect_isa();
+
+        template<std::random_access_iterator RandIt, typename Compare>
+        auto operator()(RandIt first, RandIt last, Compare &comp) const -> void {
+            using value_type = std::iter_value_t<RandIt>;
+            if constexpr (
+                std::contiguous_iterator<RandIt> && NetworkSortable<value_type> &&
+                (std::same_as<Compare, std::less<>> || std::same_as<Compare, std::less<value_type>>)
+            ) {
+                const auto n = static_cast<std::size_t>(std::distance(first, last));
+                if (detail::network_sort_short(std::to_address(first), n, isa)) {
+                    return;
+                }
+            }
+            detail::insertion_sort(first, last, comp);
+        }
+    };
+
+    // Ascending sort of a contiguous int32, int64, float or double range with a vectorized bitonic sorting network
+    // (AVX2 or AVX-512 min/max and lane permutes, picked at runtime): one network over the whole range up to 256
+    // elements, pdq_sort with NetworkBaseCase past that. Without AVX2 it is pdq_sort alone.
+    // The networks are branch free, so the cost depends only on the length. The output is a permutation of the input,
+    // but -0 and +0 compare equal and come out in either order, and NaNs are not sorted into place
+    template<std::contiguous_iterator ContIt> requires NetworkSortable<std::iter_value_t<ContIt>>
+    auto network_sort(ContIt first, ContIt last, simd::Isa isa = simd::detect_isa()) -> void {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n <= detail::NETWORK_MAX_LEN && detail::network_sort_short(std::to_address(first), n, isa)) {
+            return;
+        }
+        if (isa >= simd::Isa::avx2) {
+            pdq_sort(first, last, std::less<>(), NetworkBaseCase{isa});
+        } else {
+            pdq_sort(first, last);
+        }
+    }
+
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace thread_pool {
+
+    // Work-stealing pool: every worker owns a deque, pops its own tasks from the back (LIFO, cache-warm)
+    // and steals from the front of other deques when it runs dry. Idle workers spin for a while before
+    // parking on a condition variable, so back-to-back fork-join calls don't pay a wake-up each time.
+    class ThreadPool {
+    public:
+        using task_type = std::function<void()>;
+
+        explicit ThreadPool(std::size_t num_workers) : queues_(std::max<std::size_t>(num_workers, 1)) {
+            workers_.reserve(queues_.size());
+            for (std::size_t i = 0; i < queues_.size(); ++i) {
+                workers_.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(park_mutex_);
+                stop_ = true;
+            }
+            park_cv_.notify_all();
+            for (auto &worker: workers_) {
+                worker.join();
+            }
+        }
+
+        [[nodiscard]] auto num_workers() const noexcept -> std::size_t {
+            return workers_.size();
+        }
+
+        // workers plus the calling thread, which helps while it waits
+        [[nodiscard]] auto concurrency() const noexcept -> std::size_t {
+            return workers_.size() + 1;
+        }
+
+        auto submit(task_type task) -> void {
+            const auto idx = owner_ == this
+                             ? worker_index_
+                             : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+            {
+                // counted under the queue lock, so a thief cannot pop and decrement before the increment
+                std::lock_guard lock(queues_[idx].mutex);
+                pending_.fetch_add(1);
+                queues_[idx].tasks.push_back(std::move(task));
+            }
+            if (sleeping_.load() > 0) {
+                { std::lock_guard lock(park_mutex_); }
+                park_cv_.notify_one();
+            }
+        }
+
+        // runs one queued task on the calling thread, returns false if there was nothing to run
+        auto try_run_one() -> bool {
+            task_type task;
+            if (!try_pop(task)) {
+                return false;
+            }
+            task();
+            return true;
+        }
+
+        // fork-join loop over [first, last): ranges are split in halves down to grain,
+        // the left halves become stealable tasks and f(begin, end) runs on the leaves
+        template<typename F>
+        auto parallel_for(std::size_t first, std::size_t last, std::size_t grain, const F &f) -> void;
+
+    private:
+        struct alignas(64) Queue {
+            std::mutex mutex;
+            std::deque<task_type> tasks;
+        };
+
+        static constexpr std::size_t spin_count = 1'024;
+
+        static inline thread_local ThreadPool *owner_ = nullptr;
+        static inline thread_local std::size_t worker_index_ = 0;
+
+        auto try_pop(task_type &task) -> bool {
+            const auto n = queues_.size();
+            const bool is_worker = owner_ == this;
+            const auto home = is_worker ? worker_index_ : next_queue_.load(std::memory_order_relaxed) % n;
+
+            if (is_worker) {
+                auto &q = queues_[home];
+                std::lock_guard lock(q.mutex);
+                if (!q.tasks.empty()) {
+                    task = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                    pending_.fetch_sub(1);
+                    return true;
+                }
+            }
+
+            for (std::size_t i = is_worker ? 1 : 0; i < n; ++i) {
+                auto &q = queues_[(home + i) % n];
+                std::lock_guard lock(q.mutex);
+                if (!q.tasks.empty()) {
+                    task = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                    pending_.fetch_sub(1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        auto worker_loop(std::size_t idx) -> void {
+            owner_ = this;
+            worker_index_ = idx;
+
+            while (true) {
+                if (try_run_one()) {
+                    continue;
+                }
+
+                bool has_work = false;
+                for (std::size_t spin = 0; spin < spin_count && !has_work; ++spin) {
+                    has_work = pending_.load() > 0;
+                    if (!has_work) {
+                        std::this_thread::yield();
+                    }
+                }
+                if (has_work) {
+                    continue;
+                }
+
+                std::unique_lock lock(park_mutex_);
+                sleeping_.fetch_add(1);
+                park_cv_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+                sleeping_.fetch_sub(1);
+                if (stop_ && pending_.load() == 0) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<Queue> queues_;
+        std::vector<std::thread> workers_;
+
+        std::atomic<std::size_t> next_queue_{0};
+        std::atomic<std::size_t> pending_{0};
+        std::atomic<std::size_t> sleeping_{0};
+
+        std::mutex park_mutex_;
+        std::condition_variable park_cv_;
+        bool stop_ = false;
+    };
+
+    // Fork-join scope: run() forks a task into the pool, wait() joins them all.
+    // The waiting thread executes queued tasks instead of blocking, so nested groups can't deadlock.
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool &pool) : pool_(pool) {}
+
+        TaskGroup(const TaskGroup &) = delete;
+
+        auto operator=(const TaskGroup &) -> TaskGroup & = delete;
+
+        ~TaskGroup() {
+            while (pending_.load(std::memory_order_acquire) > 0) {
+                if (!pool_.try_run_one()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        template<typename F>
+        auto run(F &&f) -> void {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.submit([this, f = std::forward<F>(f)]() mutable {
+                try {
+                    f();
+                } catch (...) {
+                    std::lock_guard lock(error_mutex_);
+                    if (!error_) {
+                        error_ = std::current_exception();
+                    }
+                }
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        // rethrows the first exception thrown by a task of this group
+        auto wait() -> void {
+            while (pending_.load(std::memory_order_acquire) > 0) {
+                if (!pool_.try_run_one()) {
+                    std::this_thread::yield();
+                }
+            }
+            if (error_) {
+                std::rethrow_exception(std::exchange(error_, nullptr));
+            }
+        }
+
+    private:
+        ThreadPool &pool_;
+        std::atomic<std::size_t> pending_{0};
+        std::mutex error_mutex_;
+        std::exception_ptr error_;
+    };
+
+    template<typename F>
+    auto ThreadPool::parallel_for(std::size_t first, std::size_t last, std::size_t grain, const F &f) -> void {
+        if (first >= last) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+
+        TaskGroup group(*this);
+        while (last - first > grain) {
+            const auto mid = first + (last - first) / 2;
+            group.run([this, mid, last, grain, &f] { parallel_for(mid, last, grain, f); });
+            last = mid;
+        }
+        f(first, last);
+        group.wait();
+    }
+
+    // process-wide pool, the caller of a fork-join takes the place of the last hardware thread
+    inline auto instance() -> ThreadPool & {
+        static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return pool;
+    }
+
+}
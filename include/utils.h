@@ -4,6 +4,12 @@
 #include <random>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "simd_math.h"
 
 namespace utils {
 
@@ -40,6 +46,66 @@ namespace utils {
                    + std::lgamma(x * y);
         }
 
+        // unary_func and binary_func rewritten over the branch-free simd_math kernels so that a loop over them
+        // vectorizes: tan(atan(x)) = x, sinh(log(x)) = (x - 1 / x) / 2, pow(x, a) = exp(a log(x)),
+        // exp2(x) = exp(x ln2), cbrt(tgamma(x + 1)) = exp((lgamma(x) + log(x)) / 3).
+        // Valid where the originals are real and finite: legendre(3, x) > 0 and exp(exp(x)) finite
+
+        template<std::floating_point Value>
+        [[maybe_unused]] auto unary_func_simd(Value x) -> Value {
+            Value s, c;
+            simd_math::sin_cos(x, s, c);
+            const auto e = simd_math::exp(x);
+            const auto log_x = simd_math::log(x);
+            const auto lgamma_x = simd_math::lgamma_positive(x);
+            const auto legendre_3 = (5 * x * x * x - 3 * x) / 2;
+            return s
+                   + c * e
+                   - log_x
+                   + simd_math::exp(Value(-0.5) * simd_math::log(legendre_3))
+                   + simd_math::exp(Value(2.5) * log_x + x * Value(0.69314718055994530942))
+                   - simd_math::exp((lgamma_x + log_x) / 3)
+                   + (x - 1 / x) / 2
+                   - (simd_math::exp(e) + simd_math::exp(-e)) / 2
+                   + x
+                   + lgamma_x;
+        }
+
+        template<std::floating_point Value>
+        [[maybe_unused]] auto binary_func_simd(Value x, Value y) -> Value {
+            const auto xy = x * y, x_plus_y = x + y;
+            Value s, c, unused;
+            simd_math::sin_cos(xy, s, unused);
+            simd_math::sin_cos(x, unused, c);
+            const auto log_sum = simd_math::log(x_plus_y);
+            const auto log_xy = simd_math::log(xy);
+            const auto lgamma_xy = simd_math::lgamma_positive(xy);
+            const auto e = simd_math::exp(x_plus_y);
+            const auto legendre_3 = (5 * x * x * x - 3 * x) / 2;
+            return s
+                   + c * simd_math::exp(y)
+                   - log_sum
+                   + simd_math::exp(Value(-0.5) * simd_math::log(legendre_3))
+                   + simd_math::exp(Value(3.5) * log_sum)
+                   - simd_math::exp((lgamma_xy + log_xy) / 3)
+                   + (xy - 1 / xy) / 2
+                   - (simd_math::exp(e) + simd_math::exp(-e)) / 2
+                   + xy
+                   + lgamma_xy;
+        }
+
+        // out[i] = unary_func(x[i]), a vector register of elements at a time
+        template<std::floating_point Value>
+        [[maybe_unused]] auto unary_func_batch(const Value *x, Value *out, std::size_t n) -> void {
+            simd_math::transform(x, out, n, [](Value v) { return unary_func_simd(v); });
+        }
+
+        // out[i] = binary_func(x[i], y[i]), a vector register of elements at a time
+        template<std::floating_point Value>
+        [[maybe_unused]] auto binary_func_batch(const Value *x, const Value *y, Value *out, std::size_t n) -> void {
+            simd_math::transform(x, y, out, n, [](Value a, Value b) { return binary_func_simd(a, b); });
+        }
+
         template<Numeric Value>
         [[maybe_unused]] auto num_sin_integration(Value x) -> Value {
             constexpr std::size_t n = 1'000;
@@ -134,6 +200,167 @@ namespace utils {
         }
     }
 
+    // Input shapes for the sort benchmarks. Real data is rarely uniform, and algorithm rankings change with the shape
+    enum class Distribution {
+        uniform,        // independent uniform values
+        sorted,         // uniform values in ascending order
+        reversed,       // uniform values in descending order
+        nearly_sorted,  // sorted with 1% of the elements swapped with random positions
+        organ_pipe,     // ascending first half, descending second half
+        few_unique,     // 16 distinct values
+        zipf,           // 4096 distinct values with Zipf(1) frequencies, hot values spread over the range
+        sorted_runs,    // sorted runs of 4096 elements with 1% of the elements replaced by random values
+    };
+
+    inline constexpr std::array<Distribution, 8> distributions = {
+        Distribution::uniform, Distribution::sorted, Distribution::reversed, Distribution::nearly_sorted,
+        Distribution::organ_pipe, Distribution::few_unique, Distribution::zipf, Distribution::sorted_runs
+    };
+
+    constexpr auto distribution_name(Distribution dist) -> const char * {
+        switch (dist) {
+            case Distribution::sorted:
+                return "sorted";
+            case Distribution::reversed:
+                return "reversed";
+            case Distribution::nearly_sorted:
+                return "nearly_sorted";
+            case Distribution::organ_pipe:
+                return "organ_pipe";
+            case Distribution::few_unique:
+                return "few_unique";
+            case Distribution::zipf:
+                return "zipf";
+            case Distribution::sorted_runs:
+                return "sorted_runs";
+            default:
+                return "uniform";
+        }
+    }
+
+    // the distributions as benchmark arguments, see dist_input
+    inline auto distribution_args() -> std::vector<std::int64_t> {
+        std::vector<std::int64_t> args;
+        for (const auto dist : distributions) {
+            args.push_back(static_cast<std::int64_t>(dist));
+        }
+        return args;
+    }
+
+    namespace detail {
+
+        // seed used when the caller does not pick one, the same seed gives the same data
+        inline constexpr std::uint64_t DIST_SEED = 42;
+        // one element in DIST_NOISE_DIV is disturbed in nearly_sorted and sorted_runs
+        inline constexpr std::size_t DIST_NOISE_DIV = 100;
+        // distinct values of few_unique
+        inline constexpr std::size_t DIST_FEW_UNIQUE = 16;
+        // distinct values and exponent of zipf
+        inline constexpr std::size_t DIST_ZIPF_VALUES = 4096;
+        inline constexpr double DIST_ZIPF_EXPONENT = 1.0;
+        // run length of sorted_runs
+        inline constexpr std::size_t DIST_RUN_LEN = 4096;
+
+    }
+
+    // Fills [first, last) with values in [min_val, max_val] shaped by dist, deterministic in seed
+    template<typename Iter>
+    requires std::random_access_iterator<Iter> && Numeric<typename std::iterator_traits<Iter>::value_type>
+    auto fill_dist_range(
+        Iter first, Iter last, Distribution dist,
+        typename std::iterator_traits<Iter>::value_type min_val,
+        typename std::iterator_traits<Iter>::value_type max_val,
+        std::uint64_t seed = detail::DIST_SEED
+    ) -> void {
+        using Value = typename std::iterator_traits<Iter>::value_type;
+
+        const auto size = static_cast<std::size_t>(last - first);
+        if (size == 0) {
+            return;
+        }
+
+        std::mt19937_64 gen(seed);
+        typename detail::RndDis<Value>::type dis{min_val, max_val};
+        const auto rnd_value = [&] { return dis(gen); };
+        const auto rnd_index = [&](std::size_t n) { return std::uniform_int_distribution<std::size_t>{0, n - 1}(gen); };
+        const auto noise_count = std::max<std::size_t>(size / detail::DIST_NOISE_DIV, 1);
+
+        switch (dist) {
+            case Distribution::uniform:
+                std::generate(first, last, rnd_value);
+                break;
+            case Distribution::sorted:
+                std::generate(first, last, rnd_value);
+                std::sort(first, last);
+                break;
+            case Distribution::reversed:
+                std::generate(first, last, rnd_value);
+                std::sort(first, last, std::greater<>());
+                break;
+            case Distribution::nearly_sorted:
+                std::generate(first, last, rnd_value);
+                std::sort(first, last);
+                for (std::size_t i = 0; i < noise_count; ++i) {
+                    std::iter_swap(first + rnd_index(size), first + rnd_index(size));
+                }
+                break;
+            case Distribution::organ_pipe: {
+                std::generate(first, last, rnd_value);
+                const auto mid = first + size / 2;
+                std::sort(first, mid);
+                std::sort(mid, last, std::greater<>());
+                break;
+            }
+            case Distribution::few_unique: {
+                std::array<Value, detail::DIST_FEW_UNIQUE> values;
+                std::generate(std::begin(values), std::end(values), rnd_value);
+                std::generate(first, last, [&] { return values[rnd_index(values.size())]; });
+                break;
+            }
+            case Distribution::zipf: {
+                // rank r is drawn with probability proportional to 1 / (r + 1)^s through the inverse of its CDF
+                std::vector<Value> values(detail::DIST_ZIPF_VALUES);
+                std::generate(std::begin(values), std::end(values), rnd_value);
+                std::vector<double> cdf(detail::DIST_ZIPF_VALUES);
+                double total = 0.0;
+                for (std::size_t r = 0; r < cdf.size(); ++r) {
+                    total += std::pow(static_cast<double>(r + 1), -detail::DIST_ZIPF_EXPONENT);
+                    cdf[r] = total;
+                }
+                std::uniform_real_distribution<double> u{0.0, total};
+                std::generate(first, last, [&] {
+                    const auto rank = std::upper_bound(std::begin(cdf), std::end(cdf), u(gen)) - std::begin(cdf);
+                    return values[std::min(static_cast<std::size_t>(rank), values.size() - 1)];
+                });
+                break;
+            }
+            case Distribution::sorted_runs:
+                std::generate(first, last, rnd_value);
+                for (std::size_t i = 0; i < size; i += detail::DIST_RUN_LEN) {
+                    std::sort(first + i, first + std::min(i + detail::DIST_RUN_LEN, size));
+                }
+                for (std::size_t i = 0; i < noise_count; ++i) {
+                    first[rnd_index(size)] = rnd_value();
+                }
+                break;
+        }
+    }
+
+    // Benchmark input of state.range(0) elements shaped by the distribution state.range(1), generated with the fixed
+    // default seed. The distribution name labels the case, which fills the label column of the CSV output
+    template<typename Container, typename State>
+    auto dist_input(
+        State &state,
+        typename Container::value_type min_val,
+        typename Container::value_type max_val
+    ) -> Container {
+        const auto dist = static_cast<Distribution>(state.range(1));
+        state.SetLabel(distribution_name(dist));
+        Container input(state.range(0));
+        fill_dist_range(std::begin(input), std::end(input), dist, min_val, max_val);
+        return input;
+    }
+
     template<typename Container>
     [[maybe_unused]] auto get_data(
         std::size_t size,
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <ranges>
+#include <tuple>
+#include <utility>
+
+#include <omp.h>
 
 namespace zip {
 
@@ -40,4 +48,106 @@ namespace zip {
         return d_first + size;
     }
 
+    // N-ary zip: out[i] = op(in1[i], in2[i], ...) over the common length of the inputs. When op returns a tuple-like
+    // value, out is a std::tuple of iterators and the k-th component goes to the k-th of them, so one pass can fill
+    // several structure-of-arrays columns. The returned output is advanced past the last written element
+
+    namespace detail {
+
+        template<typename T>
+        inline constexpr bool is_tuple_v = false;
+
+        template<typename... Ts>
+        inline constexpr bool is_tuple_v<std::tuple<Ts...>> = true;
+
+        template<typename Out, typename Result>
+        auto store(const Out &out, std::size_t i, Result &&res) -> void {
+            if constexpr (is_tuple_v<Out>) {
+                [&]<std::size_t... K>(std::index_sequence<K...>) {
+                    ((std::get<K>(out)[i] = std::get<K>(std::forward<Result>(res))), ...);
+                }(std::make_index_sequence<std::tuple_size_v<Out>>{});
+            } else {
+                out[i] = std::forward<Result>(res);
+            }
+        }
+
+        template<typename Out>
+        auto advance(Out out, std::size_t n) -> Out {
+            if constexpr (is_tuple_v<Out>) {
+                return std::apply([n](auto... its) { return Out(its + n...); }, out);
+            } else {
+                return out + n;
+            }
+        }
+
+        // [i_first, i_last) of the zip, vectorized across elements whatever the number of streams. A tuple result
+        // gets lane-private storage under omp simd, which GCC can't vectorize, so that case only asserts
+        // independent iterations and leaves the vectorization to the compiler
+        template<typename NaryOp, typename Out, typename RandIt, typename... RandIts>
+        auto simd_zip_range(
+            const NaryOp &op, Out outs, std::size_t i_first, std::size_t i_last, RandIt first, RandIts... firsts
+        ) -> void {
+            if constexpr (is_tuple_v<Out>) {
+#pragma GCC ivdep
+                for (auto i = i_first; i < i_last; ++i) {
+                    store(outs, i, std::invoke(op, first[i], firsts[i]...));
+                }
+            } else {
+#pragma omp simd
+                for (auto i = i_first; i < i_last; ++i) {
+                    store(outs, i, std::invoke(op, first[i], firsts[i]...));
+                }
+            }
+        }
+
+        template<std::ranges::sized_range... Ranges>
+        auto common_size(const Ranges &... ins) -> std::size_t {
+            return std::min({static_cast<std::size_t>(std::ranges::size(ins))...});
+        }
+
+    }
+
+    template<
+        typename NaryOp, typename Out,
+        std::ranges::random_access_range Range, std::ranges::random_access_range... Ranges
+    > requires std::ranges::sized_range<Range> && (std::ranges::sized_range<Ranges> && ...)
+    auto zip_n(NaryOp op, Out out, const Range &in, const Ranges &... ins) -> Out {
+        const auto n = detail::common_size(in, ins...);
+        [&](auto outs, auto first, auto... firsts) {
+            for (std::size_t i = 0; i < n; ++i) {
+                detail::store(outs, i, std::invoke(op, first[i], firsts[i]...));
+            }
+        }(out, std::ranges::cbegin(in), std::ranges::cbegin(ins)...);
+        return detail::advance(out, n);
+    }
+
+    template<
+        typename NaryOp, typename Out,
+        std::ranges::random_access_range Range, std::ranges::random_access_range... Ranges
+    > requires std::ranges::sized_range<Range> && (std::ranges::sized_range<Ranges> && ...)
+    auto simd_zip_n(NaryOp op, Out out, const Range &in, const Ranges &... ins) -> Out {
+        const auto n = detail::common_size(in, ins...);
+        detail::simd_zip_range(op, out, 0, n, std::ranges::cbegin(in), std::ranges::cbegin(ins)...);
+        return detail::advance(out, n);
+    }
+
+    // one contiguous, vectorized block per thread
+    template<
+        typename NaryOp, typename Out,
+        std::ranges::random_access_range Range, std::ranges::random_access_range... Ranges
+    > requires std::ranges::sized_range<Range> && (std::ranges::sized_range<Ranges> && ...)
+    auto openmp_zip_n(NaryOp op, Out out, const Range &in, const Ranges &... ins) -> Out {
+        const auto n = detail::common_size(in, ins...);
+#pragma omp parallel
+        {
+            const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+            const auto tid = static_cast<std::size_t>(omp_get_thread_num());
+            detail::simd_zip_range(
+                op, out, n * tid / num_threads, n * (tid + 1) / num_threads,
+                std::ranges::cbegin(in), std::ranges::cbegin(ins)...
+            );
+        }
+        return detail::advance(out, n);
+    }
+
 }
\ No newline at end of file
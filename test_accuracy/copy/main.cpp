@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+#include <omp.h>
+
 #include "copy.h"
+#include "flat_string_vector.h"
+#include "simd.h"
 #include "utils.h"
 
 TEST(CopyNaiveLoopAlg, NumericTest) {
@@ -92,6 +100,201 @@ TEST(CopyOpenMPAlg, StringTest) {
     ASSERT_TRUE(std::equal(std::cbegin(to1), std::cend(to1), std::cbegin(to2)));
 }
 
+TEST(CopyStreamAlg, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        // odd sizes and offsets cover the unaligned head and tail around the streamed lines
+        for (std::size_t size : {0, 1, 63, 64, 65, 1'000, 100'003}) {
+            for (std::size_t offset : {0, 1, 13}) {
+                std::vector<char> from(size + offset), to(size + offset);
+                utils::fill_rnd_str(std::begin(from), std::end(from));
+
+                const auto res_it = copy::stream_alg(
+                    std::cbegin(from) + offset, std::cend(from), std::begin(to) + offset, isa
+                );
+
+                ASSERT_EQ(res_it, std::end(to));
+                ASSERT_TRUE(std::equal(std::cbegin(from) + offset, std::cend(from), std::cbegin(to) + offset));
+            }
+        }
+    }
+}
+
+TEST(CopyLoopAlg, StreamingThresholdTest) {
+    constexpr std::size_t size = 100'003;
+    const double max_v = 100'000, min_v = -max_v;
+    std::vector<double> from(size), to(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), min_v, max_v);
+
+    copy::set_streaming_llc_fraction(0.0);
+    const auto res_it = copy::loop_alg(std::cbegin(from), std::cend(from), std::begin(to));
+    copy::set_streaming_llc_fraction(copy::detail::STREAMING_LLC_FRACTION);
+
+    ASSERT_EQ(res_it, std::end(to));
+    ASSERT_TRUE(std::equal(std::cbegin(from), std::cend(from), std::cbegin(to)));
+}
+
+TEST(CopyOpenMPMemcpyAlg, NumericTest) {
+    omp_set_num_threads(std::max(omp_get_max_threads(), 4));
+    const auto threshold = copy::parallel_copy_threshold();
+
+    // a zero threshold forces the chunked path even on small inputs
+    for (std::size_t parallel_threshold : {std::size_t{0}, threshold}) {
+        copy::set_parallel_copy_threshold(parallel_threshold);
+        for (std::size_t size : {0, 1, 100'003, 1'000'003}) {
+            for (std::size_t offset : {0, 3}) {
+                std::vector<int> from(size + offset), to(size + offset);
+                utils::fill_rnd_range(std::begin(from), std::end(from), -100'000, 100'000);
+
+                const auto res_it = copy::openmp_memcpy_alg(std::cbegin(from) + offset, std::cend(from), std::begin(to) + offset);
+
+                ASSERT_EQ(res_it, std::end(to));
+                ASSERT_TRUE(std::equal(std::cbegin(from) + offset, std::cend(from), std::cbegin(to) + offset));
+            }
+        }
+    }
+    copy::set_parallel_copy_threshold(threshold);
+}
+
+static_assert(std::random_access_iterator<flat_str::FlatStringVector::const_iterator>);
+
+TEST(CopyFlatAlg, StringTest) {
+    constexpr std::size_t data_size = 100'000;
+    std::vector<std::string> strings(data_size);
+    for (std::size_t i = 0; i < data_size; ++i) {
+        strings[i].resize(i % 150);
+        utils::fill_rnd_str(std::begin(strings[i]), std::end(strings[i]));
+    }
+
+    const flat_str::FlatStringVector from(strings);
+    ASSERT_EQ(from.size(), data_size);
+    ASSERT_TRUE(std::equal(std::begin(from), std::end(from), std::cbegin(strings), std::cend(strings)));
+
+    flat_str::FlatStringVector to1, to2;
+    to2.push_back("stale content");
+    copy::flat_loop_alg(from, to1);
+    copy::flat_openmp_alg(from, to2);
+
+    ASSERT_EQ(from, to1);
+    ASSERT_EQ(from, to2);
+    ASSERT_TRUE(std::equal(std::begin(to2), std::end(to2), std::cbegin(strings), std::cend(strings)));
+
+    // a moved-from container is empty and stays usable
+    auto moved = std::move(to1);
+    ASSERT_EQ(moved, from);
+    ASSERT_EQ(to1.size(), 0);
+    ASSERT_TRUE(to1.empty());
+    ASSERT_EQ(std::begin(to1), std::end(to1));
+    ASSERT_EQ(to1, flat_str::FlatStringVector{});
+    copy::flat_loop_alg(to1, to2);
+    ASSERT_TRUE(to2.empty());
+    to1.clear();
+    to1.push_back("abc");
+    ASSERT_EQ(to1.size(), 1);
+    ASSERT_EQ(to1[0], "abc");
+    moved.clear();
+    ASSERT_TRUE(moved.empty());
+}
+
+TEST(CopyPmrAlg, StringTest) {
+    constexpr std::size_t data_size = 100'000, str_size = 100;
+    std::vector<std::pmr::string> from(data_size, std::pmr::string(str_size, char{}));
+    for (auto &s : from) {
+        utils::fill_rnd_str(std::begin(s), std::end(s));
+    }
+
+    std::allocator<std::pmr::string> storage_alloc;
+    const auto to1 = storage_alloc.allocate(data_size);
+    const auto to2 = storage_alloc.allocate(data_size);
+
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        copy::ThreadResources resources(4);
+
+        const auto res_it1 = copy::pmr_loop_alg(std::cbegin(from), std::cend(from), to1, resource);
+        const auto res_it2 = copy::openmp_pmr_alg(std::cbegin(from), std::cend(from), to2, resources);
+
+        ASSERT_EQ(res_it1, to1 + data_size);
+        ASSERT_EQ(res_it2, to2 + data_size);
+        ASSERT_TRUE(std::equal(std::cbegin(from), std::cend(from), to1));
+        ASSERT_TRUE(std::equal(std::cbegin(from), std::cend(from), to2));
+        for (std::size_t i = 0; i < data_size; ++i) {
+            ASSERT_EQ(to1[i].get_allocator().resource(), &resource);
+            const auto owner = to2[i].get_allocator().resource();
+            ASSERT_TRUE(owner == &resources[0] || owner == &resources[1] || owner == &resources[2] || owner == &resources[3]);
+        }
+
+        std::destroy_n(to1, data_size);
+        std::destroy_n(to2, data_size);
+    }
+    storage_alloc.deallocate(to1, data_size);
+    storage_alloc.deallocate(to2, data_size);
+}
+
+static_assert(copy::is_trivially_relocatable_v<int>);
+static_assert(copy::is_trivially_relocatable_v<std::vector<int>>);
+static_assert(!copy::is_trivially_relocatable_v<std::string>);
+
+template<typename Value>
+auto make_objects(std::size_t size) -> std::vector<Value> {
+    std::vector<Value> res(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        res[i].resize(i % 40);
+        if constexpr (std::is_same_v<Value, std::string>) {
+            utils::fill_rnd_str(std::begin(res[i]), std::end(res[i]));
+        } else {
+            utils::fill_rnd_range(std::begin(res[i]), std::end(res[i]), -100, 100);
+        }
+    }
+    return res;
+}
+
+template<typename Value>
+auto check_uninitialized(bool parallel) -> void {
+    constexpr std::size_t size = 100'003;
+    const auto from = make_objects<Value>(size);
+    std::allocator<Value> alloc;
+    const auto buf1 = alloc.allocate(size);
+    const auto buf2 = alloc.allocate(size);
+
+    // copy into buf1, move buf1 into buf2, relocate buf2 back into buf1
+    const auto res_it1 = parallel
+                         ? copy::openmp_uninitialized_copy_alg(std::cbegin(from), std::cend(from), buf1)
+                         : copy::uninitialized_copy_alg(std::cbegin(from), std::cend(from), buf1);
+    ASSERT_EQ(res_it1, buf1 + size);
+    ASSERT_TRUE(std::equal(std::cbegin(from), std::cend(from), buf1));
+
+    const auto res_it2 = parallel
+                         ? copy::openmp_uninitialized_move_alg(buf1, buf1 + size, buf2)
+                         : copy::uninitialized_move_alg(buf1, buf1 + size, buf2);
+    ASSERT_EQ(res_it2, buf2 + size);
+    ASSERT_TRUE(std::equal(std::cbegin(from), std::cend(from), buf2));
+    std::destroy_n(buf1, size);
+
+    const auto res_it3 = parallel
+                         ? copy::openmp_relocate_alg(buf2, buf2 + size, buf1)
+                         : copy::relocate_alg(buf2, buf2 + size, buf1);
+    ASSERT_EQ(res_it3, buf1 + size);
+    ASSERT_TRUE(std::equal(std::cbegin(from), std::cend(from), buf1));
+
+    std::destroy_n(buf1, size);
+    alloc.deallocate(buf1, size);
+    alloc.deallocate(buf2, size);
+}
+
+TEST(CopyUninitializedAlg, StringTest) {
+    check_uninitialized<std::string>(false);
+    check_uninitialized<std::string>(true);
+}
+
+TEST(CopyUninitializedAlg, VectorTest) {
+    check_uninitialized<std::vector<int>>(false);
+    check_uninitialized<std::vector<int>>(true);
+}
+
 int main(int argc, char **argv) {
     std::cout << "copy accuracy tests with ASan, LSan, UBSan" << std::endl;
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include "fusion.h"
+#include "map.h"
+#include "zip.h"
+#include "reduce.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+TEST(FusionPipeline, NumericTest) {
+    thread_pool::ThreadPool pool(4);
+    constexpr std::size_t size = 100'003;
+    std::vector<int> from1(size), from2(size), tmp1(size), tmp2(size);
+    utils::fill_rnd_range(std::begin(from1), std::end(from1), -10, 10);
+    utils::fill_rnd_range(std::begin(from2), std::end(from2), -10, 10);
+
+    constexpr auto square = [](int x) { return x * x; };
+    constexpr auto mul = [](int lhs, int rhs) { return lhs * rhs; };
+
+    map::loop_alg(std::cbegin(from1), std::cend(from1), std::begin(tmp1), square);
+    zip::loop_alg(std::cbegin(tmp1), std::cend(tmp1), std::cbegin(from2), std::begin(tmp2), mul);
+    const auto expected = reduce::acc_loop_alg(std::cbegin(tmp2), std::cend(tmp2), 7);
+
+    const auto pipeline = fusion::pipe(from1) | fusion::map(square) | fusion::zip(from2, mul);
+    ASSERT_EQ(pipeline.size(), size);
+    ASSERT_EQ(pipeline | fusion::reduce(7), expected);
+    ASSERT_EQ(pipeline | fusion::openmp_reduce(7), expected);
+    ASSERT_EQ(pipeline | fusion::pool_reduce(7, std::plus(), pool), expected);
+}
+
+TEST(FusionPipeline, FloatTest) {
+    thread_pool::ThreadPool pool(4);
+    constexpr std::size_t size = 1'000'000;
+    std::vector<double> from1(size), from2(size);
+    utils::fill_rnd_range(std::begin(from1), std::end(from1), -1.0, 1.0);
+    utils::fill_rnd_range(std::begin(from2), std::end(from2), -1.0, 1.0);
+
+    constexpr auto f = [](double x) { return 2 * x + 1; };
+    constexpr auto g = [](double lhs, double rhs) { return lhs * rhs; };
+
+    const auto expected = std::transform_reduce(
+        std::cbegin(from1), std::cend(from1), std::cbegin(from2), 0.0, std::plus(),
+        [&](double lhs, double rhs) { return g(f(lhs), rhs); }
+    );
+
+    const auto pipeline = fusion::pipe(std::cbegin(from1), std::cend(from1)) | fusion::map(f) | fusion::zip(from2, g);
+    const auto serial = pipeline | fusion::reduce(0.0);
+    ASSERT_NEAR(serial, expected, 1e-9);
+    ASSERT_NEAR(pipeline | fusion::openmp_reduce(0.0), serial, 1e-9);
+    ASSERT_NEAR(pipeline | fusion::pool_reduce(0.0, std::plus(), pool), serial, 1e-9);
+}
+
+// concatenation is associative but not commutative, the parallel backends must keep the blocks in order
+TEST(FusionPipeline, OrderTest) {
+    thread_pool::ThreadPool pool(4);
+    constexpr std::size_t size = 50'000;
+    std::vector<int> from(size);
+    std::iota(std::begin(from), std::end(from), 0);
+
+    const auto pipeline = fusion::pipe(from) | fusion::map([](int x) { return std::to_string(x % 10); });
+    const auto expected = pipeline | fusion::reduce(std::string("init"));
+
+    ASSERT_EQ(expected.size(), size + 4);
+    ASSERT_EQ(pipeline | fusion::openmp_reduce(std::string("init")), expected);
+    ASSERT_EQ(pipeline | fusion::pool_reduce(std::string("init"), std::plus(), pool), expected);
+}
+
+TEST(FusionPipeline, EmptyTest) {
+    thread_pool::ThreadPool pool(4);
+    const std::vector<int> from;
+    const auto pipeline = fusion::pipe(from) | fusion::map([](int x) { return x + 1; });
+
+    ASSERT_EQ(pipeline | fusion::reduce(3), 3);
+    ASSERT_EQ(pipeline | fusion::openmp_reduce(3), 3);
+    ASSERT_EQ(pipeline | fusion::pool_reduce(3, std::plus(), pool), 3);
+}
+
+int main(int argc, char **argv) {
+    // several blocks for openmp_reduce on any machine, pool_reduce gets its own four-thread pool in every test
+    omp_set_num_threads(std::max(omp_get_max_threads(), 4));
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
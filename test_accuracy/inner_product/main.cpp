@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
 #include "inner_product.h"
+#include "simd.h"
 #include "utils.h"
 
 TEST(InnerProdLoop, NumericTest) {
@@ -31,6 +38,163 @@ TEST(InnerProdOpenMP, NumericTest) {
     ASSERT_EQ(res2, res3);
 }
 
+TEST(InnerProdOpenMP, CustomOpsTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<int> data1(size), data2(size);
+    utils::fill_rnd_range(std::begin(data1), std::end(data1), -1'000, 1'000);
+    utils::fill_rnd_range(std::begin(data2), std::end(data2), -1'000, 1'000);
+
+    // Chebyshev distance
+    constexpr auto max_op = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+    constexpr auto abs_diff = [](int lhs, int rhs) { return std::abs(lhs - rhs); };
+
+    const auto res1 = std::inner_product(std::cbegin(data1), std::cend(data1), std::cbegin(data2), 0, max_op, abs_diff);
+    const auto res2 = inner_prod::openmp_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), 0, max_op, abs_diff, 0);
+
+    ASSERT_EQ(res1, res2);
+}
+
+template<typename Value>
+auto check_simd_inner_prod(simd::Isa isa) -> void {
+    for (std::size_t size : {0, 1, 7, 15, 63, 64, 65, 127, 129, 100'003}) {
+        std::vector<Value> data1(size), data2(size);
+        utils::fill_rnd_range(std::begin(data1), std::end(data1), Value{-3}, Value{3});
+        utils::fill_rnd_range(std::begin(data2), std::end(data2), Value{-3}, Value{3});
+
+        Value abs_sum = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            abs_sum += std::abs(data1[i] * data2[i]);
+        }
+
+        const auto res1 = std::inner_product(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Value{1});
+        const auto res2 = inner_prod::simd_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Value{1}, isa);
+
+        ASSERT_NEAR(res1, res2, (abs_sum + 1) * 16 * std::numeric_limits<Value>::epsilon());
+    }
+}
+
+TEST(InnerProdSimd, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_simd_inner_prod<float>(isa);
+        check_simd_inner_prod<double>(isa);
+    }
+}
+
+// narrow storage filled from float/int values, the reference sums the products of the stored values exactly
+template<typename Storage, typename Acc>
+auto check_mixed_inner_prod(simd::Isa isa) -> void {
+    for (std::size_t size : {0, 1, 7, 15, 63, 64, 65, 127, 129, 100'003}) {
+        std::vector<Storage> data1(size), data2(size);
+        if constexpr (std::integral<Storage>) {
+            // full range up to 16 bit, int32 values are kept small enough for the exact int64 reference
+            const int bound = sizeof(Storage) < 4 ? std::numeric_limits<Storage>::max() : 1 << 20;
+            for (auto *data : {&data1, &data2}) {
+                std::vector<int> values(size);
+                utils::fill_rnd_range(std::begin(values), std::end(values), -bound - 1, bound);
+                std::transform(std::cbegin(values), std::cend(values), std::begin(*data),
+                               [](int v) { return static_cast<Storage>(v); });
+            }
+            // int32 accumulators wrap modulo 2^32, compare against the wrapped exact result
+            const auto exact = std::inner_product(
+                std::cbegin(data1), std::cend(data1), std::cbegin(data2), std::int64_t{1}, std::plus(),
+                [](std::int64_t lhs, std::int64_t rhs) { return lhs * rhs; }
+            );
+            const auto res = inner_prod::mixed_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Acc{1}, isa);
+            ASSERT_EQ(static_cast<std::uint64_t>(res), static_cast<std::uint64_t>(static_cast<Acc>(exact)));
+        } else {
+            for (auto *data : {&data1, &data2}) {
+                std::vector<float> values(size);
+                utils::fill_rnd_range(std::begin(values), std::end(values), -3.0f, 3.0f);
+                std::transform(std::cbegin(values), std::cend(values), std::begin(*data),
+                               [](float v) { return static_cast<Storage>(v); });
+            }
+            long double expected = 1, abs_sum = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto product = static_cast<long double>(data1[i]) * static_cast<long double>(data2[i]);
+                expected += product;
+                abs_sum += std::abs(product);
+            }
+            const auto res = inner_prod::mixed_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Acc{1}, isa);
+            ASSERT_NEAR(res, expected, (abs_sum + 1) * 16 * std::numeric_limits<Acc>::epsilon());
+        }
+    }
+}
+
+TEST(InnerProdMixed, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_mixed_inner_prod<simd::float16, float>(isa);
+        check_mixed_inner_prod<simd::bfloat16, float>(isa);
+        check_mixed_inner_prod<simd::float16, double>(isa);
+        check_mixed_inner_prod<simd::bfloat16, double>(isa);
+        check_mixed_inner_prod<float, double>(isa);
+        check_mixed_inner_prod<std::int8_t, std::int32_t>(isa);
+        check_mixed_inner_prod<std::int8_t, std::int64_t>(isa);
+        check_mixed_inner_prod<std::int16_t, std::int64_t>(isa);
+        check_mixed_inner_prod<std::int32_t, std::int64_t>(isa);
+    }
+}
+
+// -32768 * -32768 pairs: the products sum past int32, the int64 accumulator holds them
+TEST(InnerProdMixed, OpenMPWideningTest) {
+    constexpr std::size_t size = 100'003;
+    std::vector<std::int16_t> data(size, std::numeric_limits<std::int16_t>::min());
+
+    const auto expected = static_cast<std::int64_t>(size) * 32'768 * 32'768;
+    ASSERT_EQ(inner_prod::mixed_openmp_alg(std::cbegin(data), std::cend(data), std::cbegin(data), std::int64_t{0}),
+              expected);
+
+    std::vector<simd::bfloat16> ones(size, simd::bfloat16(1.0f));
+    ASSERT_EQ(inner_prod::mixed_openmp_alg(std::cbegin(ones), std::cend(ones), std::cbegin(ones), 0.0f),
+              static_cast<float>(size));
+}
+
+template<typename Value>
+auto check_batched_inner_prod(simd::Isa isa) -> void {
+    // dims below one vector, across a column chunk, row counts around the tile and block sizes
+    for (std::size_t dim : {1, 3, 64, 257, 1'100}) {
+        for (std::size_t num_rows : {1, 5, 37, 100}) {
+            for (std::size_t num_queries : {1, 2, 3, 5}) {
+                std::vector<Value> rows(num_rows * dim), queries(num_queries * dim), res(num_rows * num_queries);
+                utils::fill_rnd_range(std::begin(rows), std::end(rows), Value{-3}, Value{3});
+                utils::fill_rnd_range(std::begin(queries), std::end(queries), Value{-3}, Value{3});
+
+                const auto last = inner_prod::batched(std::cbegin(rows), std::cend(rows), std::cbegin(queries),
+                                                      std::cend(queries), dim, std::begin(res), isa);
+                ASSERT_EQ(last, std::end(res));
+
+                for (std::size_t q = 0; q < num_queries; ++q) {
+                    for (std::size_t r = 0; r < num_rows; ++r) {
+                        const auto row = std::cbegin(rows) + static_cast<std::ptrdiff_t>(r * dim);
+                        const auto query = std::cbegin(queries) + static_cast<std::ptrdiff_t>(q * dim);
+                        const auto expected = std::inner_product(row, row + static_cast<std::ptrdiff_t>(dim), query, Value{0});
+                        ASSERT_NEAR(res[q * num_rows + r], expected, 9 * dim * 16 * std::numeric_limits<Value>::epsilon())
+                            << dim << " " << num_rows << " " << num_queries;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(InnerProdBatched, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_batched_inner_prod<float>(isa);
+        check_batched_inner_prod<double>(isa);
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "map.h"
+#include "soa_vector.h"
+#include "utils.h"
+
+TEST(SoaVector, FieldTest) {
+    constexpr std::size_t size = 1'000;
+    soa::soa_vector<int, double, std::string> data;
+    for (std::size_t i = 0; i < size; ++i) {
+        data.push_back(static_cast<int>(i), i * 0.5, std::to_string(i));
+    }
+
+    ASSERT_EQ(data.size(), size);
+    ASSERT_EQ(data[10], std::tuple(10, 5.0, std::string("10")));
+
+    // the columns are contiguous and writable in place
+    const auto ints = data.field<0>();
+    const auto doubles = data.field<1>();
+    ASSERT_EQ(std::to_address(std::end(ints)) - std::to_address(std::begin(ints)), static_cast<std::ptrdiff_t>(size));
+    map::loop_alg(std::cbegin(ints), std::cend(ints), std::begin(doubles), [](int x) { return x * 2.0; });
+    for (std::size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(std::get<1>(data[i]), i * 2.0);
+    }
+
+    data.resize(10);
+    ASSERT_EQ(data.size(), 10u);
+    ASSERT_EQ(data.field<2>().size(), 10u);
+    data.clear();
+    ASSERT_TRUE(data.empty());
+}
+
+TEST(SoaVector, SortByTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<std::int64_t> keys(size);
+    utils::fill_rnd_range(std::begin(keys), std::end(keys), std::int64_t{-100}, std::int64_t{100});
+
+    soa::soa_vector<double, std::int64_t, std::size_t> data;
+    std::vector<std::tuple<std::int64_t, std::size_t, double>> expected;
+    for (std::size_t i = 0; i < size; ++i) {
+        data.push_back(static_cast<double>(keys[i]) * 3, keys[i], i);
+        expected.emplace_back(keys[i], i, static_cast<double>(keys[i]) * 3);
+    }
+    std::stable_sort(std::begin(expected), std::end(expected), [](const auto &lhs, const auto &rhs) {
+        return std::get<0>(lhs) < std::get<0>(rhs);
+    });
+
+    data.sort_by<1>();
+
+    // every field follows its key and equal keys keep their order
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto [key, idx, value] = expected[i];
+        ASSERT_EQ(data[i], std::tuple(value, key, idx));
+    }
+
+    data.sort_by<1>(std::greater());
+    ASSERT_TRUE(std::is_sorted(std::cbegin(data.field<1>()), std::cend(data.field<1>()), std::greater()));
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 #include "map.h"
+#include "simd.h"
+#include "simd_math.h"
 #include "utils.h"
 
 TEST(MapLoopAlg, NumericTest) {
@@ -35,6 +42,246 @@ TEST(MapOpenMPAlg, NumericTest) {
     ASSERT_TRUE(std::equal(std::cbegin(to1), std::cend(to1), std::cbegin(to2)));
 }
 
+TEST(MapOpenMPAlg, ScheduleTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<int> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -10, 10);
+
+    constexpr auto closure = [](auto val) { return val * val; };
+    std::transform(std::cbegin(from), std::cend(from), std::begin(to2), closure);
+
+    for (const auto schedule: {
+             map::Schedule{omp_sched_static, 0}, map::Schedule{omp_sched_static, 7},
+             map::Schedule{omp_sched_dynamic, 1}, map::Schedule{omp_sched_guided, 100}
+         }) {
+        std::fill(std::begin(to1), std::end(to1), 0);
+        const auto res_it = map::openmp_alg(std::cbegin(from), std::cend(from), std::begin(to1), closure, schedule);
+
+        ASSERT_EQ(res_it, std::cend(to1));
+        ASSERT_EQ(to1, to2);
+    }
+}
+
+TEST(MapAdaptiveOpenMPAlg, NumericTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<double> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -10'000.0, 10'000.0);
+
+    constexpr auto op = utils::funcs::newton_sqrt<double>;
+    std::transform(std::cbegin(from), std::cend(from), std::begin(to2), op);
+
+    map::reset_schedule_cache();
+    ASSERT_FALSE(map::cached_schedule(op, size).has_value());
+
+    // the first call calibrates on a prefix, the second one runs with the cached schedule
+    for (int call = 0; call < 2; ++call) {
+        std::fill(std::begin(to1), std::end(to1), 0.0);
+        const auto res_it = map::adaptive_openmp_alg(std::cbegin(from), std::cend(from), std::begin(to1), op);
+
+        ASSERT_EQ(res_it, std::cend(to1));
+        ASSERT_EQ(to1, to2);
+        ASSERT_TRUE(map::cached_schedule(op, size).has_value());
+    }
+
+    // another function of the same type has its own entry
+    ASSERT_FALSE(map::cached_schedule(utils::funcs::unary_func<double>, size).has_value());
+}
+
+TEST(MapAdaptiveOpenMPAlg, SmallTest) {
+    for (const std::size_t size: {0, 1, 5, 100}) {
+        std::vector<int> from(size), to1(size), to2(size);
+        utils::fill_rnd_range(std::begin(from), std::end(from), -10, 10);
+
+        constexpr auto closure = [](int val) { return val + 1; };
+        const auto res_it = map::adaptive_openmp_alg(std::cbegin(from), std::cend(from), std::begin(to1), closure);
+        std::transform(std::cbegin(from), std::cend(from), std::begin(to2), closure);
+
+        ASSERT_EQ(res_it, std::cend(to1));
+        ASSERT_EQ(to1, to2);
+    }
+}
+
+// ulp distance between two floats, 0 for equal values including infinities and for two NaNs
+template<std::floating_point Value>
+auto ulp_distance(Value a, Value b) -> std::uint64_t {
+    using int_type = std::conditional_t<sizeof(Value) == 4, std::int32_t, std::int64_t>;
+    if ((std::isnan(a) && std::isnan(b)) || a == b) {
+        return 0;
+    }
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    // map the sign-magnitude bit patterns to a monotonic integer line
+    const auto ordered = [](Value v) -> std::int64_t {
+        const auto i = std::bit_cast<int_type>(v);
+        return i < 0 ? std::int64_t{std::numeric_limits<int_type>::min()} - i : i;
+    };
+    const auto diff = ordered(a) - ordered(b);
+    return static_cast<std::uint64_t>(diff < 0 ? -diff : diff);
+}
+
+constexpr auto all_isas = {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512};
+
+template<std::floating_point Value, typename SimdOp, typename StdOp>
+auto max_ulp_error(const std::vector<Value> &xs, SimdOp simd_op, StdOp std_op, simd::Isa isa) -> std::uint64_t {
+    std::vector<Value> res(xs.size());
+    simd_math::transform(xs.data(), res.data(), xs.size(), simd_op, isa);
+    std::uint64_t max_err = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        max_err = std::max(max_err, ulp_distance(res[i], std_op(xs[i])));
+    }
+    return max_err;
+}
+
+template<std::floating_point Value>
+auto rnd_values(std::size_t size, Value min_v, Value max_v) -> std::vector<Value> {
+    std::vector<Value> xs(size);
+    utils::fill_rnd_range(std::begin(xs), std::end(xs), min_v, max_v);
+    return xs;
+}
+
+// every positive finite value is equally likely to come from any binade, subnormals included
+template<std::floating_point Value>
+auto rnd_positive_values(std::size_t size) -> std::vector<Value> {
+    using uint_type = std::conditional_t<sizeof(Value) == 4, std::uint32_t, std::uint64_t>;
+    const auto max_bits = std::bit_cast<uint_type>(std::numeric_limits<Value>::max());
+    std::vector<uint_type> bits(size);
+    utils::fill_rnd_range(std::begin(bits), std::end(bits), uint_type{1}, max_bits);
+    std::vector<Value> xs(size);
+    std::transform(std::cbegin(bits), std::cend(bits), std::begin(xs), [](uint_type b) { return std::bit_cast<Value>(b); });
+    return xs;
+}
+
+template<std::floating_point Value>
+auto check_simd_math_ulp(simd::Isa isa, Value trig_range, std::uint64_t max_ulp) -> void {
+    constexpr std::size_t size = 200'000;
+
+    const auto trig_xs = rnd_values<Value>(size, -trig_range, trig_range);
+    const auto small_xs = rnd_values<Value>(size, Value(-3.2), Value(3.2));
+    for (const auto &xs : {trig_xs, small_xs}) {
+        EXPECT_LE(max_ulp_error(xs, [](Value x) { return simd_math::sin(x); }, [](Value x) { return std::sin(x); }, isa), max_ulp);
+        EXPECT_LE(max_ulp_error(xs, [](Value x) { return simd_math::cos(x); }, [](Value x) { return std::cos(x); }, isa), max_ulp);
+    }
+
+    // past both ends of the range too: overflow to inf and underflow through the subnormals to 0
+    const auto exp_xs = rnd_values<Value>(size, std::log(std::numeric_limits<Value>::denorm_min()) - 2,
+                                          std::log(std::numeric_limits<Value>::max()) + 2);
+    EXPECT_LE(max_ulp_error(exp_xs, [](Value x) { return simd_math::exp(x); }, [](Value x) { return std::exp(x); }, isa), max_ulp);
+
+    const auto log_xs = rnd_positive_values<Value>(size);
+    EXPECT_LE(max_ulp_error(log_xs, [](Value x) { return simd_math::log(x); }, [](Value x) { return std::log(x); }, isa), max_ulp);
+
+    for (const Value special : {Value{0}, Value{-1}, std::numeric_limits<Value>::infinity()}) {
+        std::vector<Value> xs{special}, res(1);
+        simd_math::transform(xs.data(), res.data(), 1, [](Value x) { return simd_math::log(x); }, isa);
+        EXPECT_EQ(ulp_distance(res[0], std::log(special)), 0u) << special;
+    }
+}
+
+TEST(SimdMath, UlpTest) {
+    for (const auto isa : all_isas) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_simd_math_ulp<double>(isa, 1e5, 2);
+        check_simd_math_ulp<float>(isa, 8'192.0f, 2);
+    }
+}
+
+template<std::floating_point Value>
+auto check_simd_pow_ulp(simd::Isa isa) -> void {
+    constexpr std::size_t size = 200'000;
+    std::vector<Value> xs = rnd_values<Value>(size, Value(-7), Value(7)), ys(size), t(size), res(size);
+    utils::fill_rnd_range(std::begin(t), std::end(t), Value(-50), Value(50));
+    for (std::size_t i = 0; i < size; ++i) {
+        xs[i] = std::exp(xs[i]);
+        ys[i] = t[i] / std::log(xs[i]);
+    }
+
+    simd_math::transform(xs.data(), ys.data(), res.data(), size, [](Value x, Value y) { return simd_math::pow(x, y); }, isa);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto y_log_x = std::abs(static_cast<double>(ys[i]) * std::log(static_cast<double>(xs[i])));
+        const auto bound = std::is_same_v<Value, float> ? 1.0 : 2.0 + 4.0 * y_log_x;
+        ASSERT_LE(static_cast<double>(ulp_distance(res[i], std::pow(xs[i], ys[i]))), bound) << xs[i] << " ^ " << ys[i];
+    }
+}
+
+// 1 ^ inf and 1 ^ NaN are 1, x ^ 0 is 1 for any x
+template<std::floating_point Value>
+auto check_simd_pow_special(simd::Isa isa) -> void {
+    constexpr auto inf = std::numeric_limits<Value>::infinity();
+    constexpr auto nan = std::numeric_limits<Value>::quiet_NaN();
+    std::vector<Value> xs{1, 1, 1, 0, inf, nan}, ys{inf, -inf, nan, 0, 0, 0}, res(xs.size());
+    simd_math::transform(xs.data(), ys.data(), res.data(), xs.size(), [](Value x, Value y) { return simd_math::pow(x, y); }, isa);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_EQ(res[i], Value{1}) << xs[i] << " ^ " << ys[i];
+    }
+}
+
+TEST(SimdMath, PowUlpTest) {
+    for (const auto isa : all_isas) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_simd_pow_ulp<double>(isa);
+        check_simd_pow_ulp<float>(isa);
+        check_simd_pow_special<double>(isa);
+        check_simd_pow_special<float>(isa);
+    }
+}
+
+template<std::floating_point Value>
+auto check_func_batch(Value tolerance) -> void {
+    constexpr std::size_t size = 10'000;
+    // inside the domain of both functions for floats too: legendre(3, x) > 0 and exp(exp(x + y)) finite.
+    // The terms are of order one or larger, so the tolerance turns absolute where the sum cancels to near zero
+    const auto xs = rnd_values<Value>(size, Value(0.8), Value(2.4));
+    const auto ys = rnd_values<Value>(size, Value(0.5), Value(2));
+    std::vector<Value> res1(size), res2(size);
+
+    utils::funcs::unary_func_batch(xs.data(), res1.data(), size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto expected = utils::funcs::unary_func(xs[i]);
+        ASSERT_NEAR(res1[i], expected, tolerance * std::max(std::abs(expected), Value{1})) << xs[i];
+    }
+
+    utils::funcs::binary_func_batch(xs.data(), ys.data(), res2.data(), size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto expected = utils::funcs::binary_func(xs[i], ys[i]);
+        ASSERT_NEAR(res2[i], expected, tolerance * std::max(std::abs(expected), Value{1})) << xs[i] << ", " << ys[i];
+    }
+}
+
+TEST(SimdMath, FuncBatchTest) {
+    check_func_batch<double>(1e-12);
+    check_func_batch<float>(1e-4f);
+}
+
+TEST(MapSimdAlg, NumericTest) {
+    constexpr std::size_t size = 100'003;
+    std::vector<double> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -10.0, 10.0);
+
+    constexpr auto closure = [](double val) { return simd_math::exp(val) * val; };
+
+    for (const auto isa : all_isas) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        const auto res_it1 = map::simd_alg(std::cbegin(from), std::cend(from), std::begin(to1), closure, isa);
+        const auto res_it2 = std::transform(std::cbegin(from), std::cend(from), std::begin(to2), closure);
+
+        ASSERT_EQ(res_it1, std::cend(to1));
+        ASSERT_EQ(res_it2, std::cend(to2));
+        for (std::size_t i = 0; i < size; ++i) {
+            ASSERT_LE(ulp_distance(to1[i], to2[i]), 2u);
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+
+#include <omp.h>
 
 #include "partial_sum.h"
 #include "utils.h"
@@ -22,7 +29,209 @@ TEST(ParSumNaiveAlg, NumericSumTest) {
     ASSERT_TRUE(std::equal(std::cbegin(to2), std::cend(to2), std::cbegin(to3)));
 }
 
+TEST(ParSumOpenMPInclusiveScan, NumericSumTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<long long> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -1'000LL, 1'000LL);
+
+    const auto res_it1 = par_sum::openmp_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1));
+    const auto res_it2 = std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2));
+
+    ASSERT_EQ(res_it1, std::cend(to1));
+    ASSERT_EQ(res_it2, std::cend(to2));
+    ASSERT_EQ(to1, to2);
+}
+
+TEST(ParSumOpenMPInclusiveScan, NonCommutativeOpTest) {
+    constexpr std::size_t size = 30'000;
+    std::vector<std::string> from(size, std::string(1, char{})), to1(size), to2(size);
+    for (auto &s : from) {
+        utils::fill_rnd_str(std::begin(s), std::end(s));
+    }
+
+    // associative but not commutative: last 8 chars of the concatenation
+    constexpr auto concat = [](const std::string &lhs, const std::string &rhs) {
+        const auto s = lhs + rhs;
+        return s.size() > 8 ? s.substr(s.size() - 8) : s;
+    };
+
+    par_sum::openmp_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1), concat);
+    std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2), concat);
+
+    ASSERT_EQ(to1, to2);
+}
+
+TEST(ParSumOpenMPExclusiveScan, NumericSumTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<long long> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -1'000LL, 1'000LL);
+
+    const auto res_it1 = par_sum::openmp_exclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1), 42LL);
+    const auto res_it2 = std::exclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2), 42LL);
+
+    ASSERT_EQ(res_it1, std::cend(to1));
+    ASSERT_EQ(res_it2, std::cend(to2));
+    ASSERT_EQ(to1, to2);
+}
+
+TEST(ParSumOpenMPExclusiveScan, MaxOpInPlaceTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<int> data(size), expected(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -100'000, 100'000);
+
+    constexpr auto max_op = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+
+    std::exclusive_scan(std::cbegin(data), std::cend(data), std::begin(expected), -200'000, max_op);
+    par_sum::openmp_exclusive_scan(std::cbegin(data), std::cend(data), std::begin(data), -200'000, max_op);
+
+    ASSERT_EQ(data, expected);
+}
+
+TEST(ParSumPoolInclusiveScan, NumericSumTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<long long> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -1'000LL, 1'000LL);
+
+    const auto res_it1 = par_sum::pool_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1));
+    const auto res_it2 = std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2));
+
+    ASSERT_EQ(res_it1, std::cend(to1));
+    ASSERT_EQ(res_it2, std::cend(to2));
+    ASSERT_EQ(to1, to2);
+}
+
+TEST(ParSumPoolInclusiveScan, NonCommutativeOpTest) {
+    constexpr std::size_t size = 30'000;
+    std::vector<std::string> from(size, std::string(1, char{})), to1(size), to2(size);
+    for (auto &s : from) {
+        utils::fill_rnd_str(std::begin(s), std::end(s));
+    }
+
+    // associative but not commutative: last 8 chars of the concatenation
+    constexpr auto concat = [](const std::string &lhs, const std::string &rhs) {
+        const auto s = lhs + rhs;
+        return s.size() > 8 ? s.substr(s.size() - 8) : s;
+    };
+
+    par_sum::pool_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1), concat);
+    std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2), concat);
+
+    ASSERT_EQ(to1, to2);
+}
+
+TEST(ParSumPoolExclusiveScan, NumericSumTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<long long> from(size), to1(size), to2(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -1'000LL, 1'000LL);
+
+    const auto res_it1 = par_sum::pool_exclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1), 42LL);
+    const auto res_it2 = std::exclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2), 42LL);
+
+    ASSERT_EQ(res_it1, std::cend(to1));
+    ASSERT_EQ(res_it2, std::cend(to2));
+    ASSERT_EQ(to1, to2);
+}
+
+TEST(ParSumPoolExclusiveScan, SmallSizesTest) {
+    for (std::size_t size : {0, 1, 2, 17, 10'001}) {
+        std::vector<int> from(size), to1(size), to2(size);
+        utils::fill_rnd_range(std::begin(from), std::end(from), -3, 3);
+
+        const auto res_it1 = par_sum::pool_exclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1), 0);
+        std::exclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2), 0);
+
+        ASSERT_EQ(res_it1, std::cend(to1));
+        ASSERT_EQ(to1, to2);
+    }
+}
+
+TEST(ParSumDecoupledInclusiveScan, NumericSumTest) {
+    for (std::size_t size : {0, 1, 9'999, 100'000, 1'000'003}) {
+        std::vector<long long> from(size), to1(size), to2(size);
+        utils::fill_rnd_range(std::begin(from), std::end(from), -1'000LL, 1'000LL);
+
+        const auto res_it1 = par_sum::decoupled_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1));
+        std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2));
+
+        ASSERT_EQ(res_it1, std::cend(to1));
+        ASSERT_EQ(to1, to2);
+    }
+}
+
+TEST(ParSumDecoupledInclusiveScan, NonCommutativeOpTest) {
+    constexpr std::size_t size = 30'000;
+    std::vector<std::string> from(size, std::string(1, char{})), to1(size), to2(size);
+    for (auto &s : from) {
+        utils::fill_rnd_str(std::begin(s), std::end(s));
+    }
+
+    // associative but not commutative: last 8 chars of the concatenation
+    constexpr auto concat = [](const std::string &lhs, const std::string &rhs) {
+        const auto s = lhs + rhs;
+        return s.size() > 8 ? s.substr(s.size() - 8) : s;
+    };
+
+    par_sum::decoupled_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1), concat);
+    std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2), concat);
+
+    ASSERT_EQ(to1, to2);
+}
+
+template<typename Value>
+auto check_simd_partial_sum(simd::Isa isa) -> void {
+    // every tail length of every register width, plus a long run
+    for (std::size_t size : {0, 1, 2, 3, 5, 8, 15, 16, 17, 31, 33, 100'003}) {
+        std::vector<Value> from(size), to1(size), to2(size);
+        utils::fill_rnd_range(std::begin(from), std::end(from), std::is_signed_v<Value> ? Value(-100) : Value{0}, Value{100});
+
+        const auto res_it1 = par_sum::simd_partial_sum(std::cbegin(from), std::cend(from), std::begin(to1), isa);
+        std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2));
+
+        ASSERT_EQ(res_it1, std::cend(to1));
+        if constexpr (std::is_integral_v<Value>) {
+            ASSERT_EQ(to1, to2);
+        } else {
+            // reassociated within a register, so compare up to rounding of the running sum magnitude
+            Value magnitude = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                magnitude += std::abs(from[i]);
+                ASSERT_NEAR(to1[i], to2[i], magnitude * 64 * std::numeric_limits<Value>::epsilon());
+            }
+        }
+    }
+}
+
+TEST(ParSumSimdPartialSum, AllIsaTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_simd_partial_sum<float>(isa);
+        check_simd_partial_sum<double>(isa);
+        check_simd_partial_sum<std::int32_t>(isa);
+        check_simd_partial_sum<std::int64_t>(isa);
+        check_simd_partial_sum<long long>(isa);
+        check_simd_partial_sum<unsigned>(isa);
+    }
+}
+
+TEST(ParSumSimdPartialSum, ParallelScanKernelTest) {
+    constexpr std::size_t size = 1'000'003;
+    std::vector<int> from(size), to1(size), to2(size), to3(size);
+    utils::fill_rnd_range(std::begin(from), std::end(from), -1'000, 1'000);
+
+    par_sum::pool_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to1));
+    par_sum::decoupled_inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to2));
+    std::inclusive_scan(std::cbegin(from), std::cend(from), std::begin(to3));
+
+    ASSERT_EQ(to1, to3);
+    ASSERT_EQ(to2, to3);
+}
+
 int main(int argc, char **argv) {
+    // more chunks than cores, so the carry propagation is exercised on any machine
+    omp_set_num_threads(std::max(omp_get_max_threads(), 4));
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <omp.h>
+
 #include "reduce.h"
+#include "simd.h"
 #include "utils.h"
 
 TEST(ReduceLoop, NumericTest) {
@@ -25,6 +35,50 @@ TEST(ReduceOpenMP, NumericTest) {
     ASSERT_EQ(res1, res2);
 }
 
+TEST(ReduceOpenMP, MinOpTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<int> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -1'000, 1'000);
+
+    constexpr auto min_op = [](int lhs, int rhs) { return std::min(lhs, rhs); };
+    constexpr auto max_int = std::numeric_limits<int>::max();
+
+    const auto res1 = *std::min_element(std::cbegin(data), std::cend(data));
+    const auto res2 = reduce::acc_openmp_alg(std::cbegin(data), std::cend(data), max_int, min_op, max_int);
+
+    ASSERT_EQ(res1, res2);
+}
+
+TEST(ReduceOpenMP, NonCommutativeStringOpTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<std::string> data(size, std::string(1, char{}));
+    for (auto &s : data) {
+        utils::fill_rnd_str(std::begin(s), std::end(s));
+    }
+
+    const auto res1 = std::accumulate(std::cbegin(data), std::cend(data), std::string("init"));
+    const auto res2 = reduce::acc_openmp_alg(
+        std::cbegin(data), std::cend(data), std::string("init"), std::plus(), std::string()
+    );
+
+    ASSERT_EQ(res1, res2);
+}
+
+TEST(ReduceOpenMP, ComplexProductTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<double> angles(size);
+    utils::fill_rnd_range(std::begin(angles), std::end(angles), -3.0, 3.0);
+    std::vector<std::complex<double>> data(size);
+    std::transform(std::cbegin(angles), std::cend(angles), std::begin(data), [](double a) { return std::polar(1.0, a); });
+
+    const std::complex<double> one = 1.0;
+    const auto res1 = std::accumulate(std::cbegin(data), std::cend(data), one, std::multiplies());
+    const auto res2 = reduce::acc_openmp_alg(std::cbegin(data), std::cend(data), one, std::multiplies(), one);
+
+    ASSERT_NEAR(res1.real(), res2.real(), 1e-9);
+    ASSERT_NEAR(res1.imag(), res2.imag(), 1e-9);
+}
+
 TEST(ReduceNaiveThread, NumericTest) {
     constexpr std::size_t size = 10'000;
     std::vector<int> data(size);
@@ -47,6 +101,277 @@ TEST(ReduceNaiveAsync, NumericTest) {
     ASSERT_EQ(res1, res2);
 }
 
+TEST(ReducePool, NumericTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<int> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -3, 3);
+
+    const auto res1 = std::accumulate(std::cbegin(data), std::cend(data), 0);
+    const auto res2 = reduce::pool_reduce(std::cbegin(data), std::cend(data), 0);
+
+    ASSERT_EQ(res1, res2);
+}
+
+TEST(ReducePool, CustomOpTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<int> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -1'000, 1'000);
+
+    constexpr auto max_op = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+
+    const auto res1 = *std::max_element(std::cbegin(data), std::cend(data));
+    const auto res2 = reduce::pool_reduce(std::cbegin(data), std::cend(data), -1'001, max_op);
+
+    ASSERT_EQ(res1, res2);
+}
+
+template<typename Value>
+auto check_simd_reduce(simd::Isa isa) -> void {
+    for (std::size_t size : {0, 1, 7, 15, 63, 64, 65, 127, 129, 100'003}) {
+        std::vector<Value> data(size);
+        utils::fill_rnd_range(std::begin(data), std::end(data), Value{-3}, Value{3});
+
+        Value abs_sum = 0;
+        for (const auto v : data) {
+            abs_sum += std::abs(v);
+        }
+
+        const auto res1 = std::accumulate(std::cbegin(data), std::cend(data), Value{1});
+        const auto res2 = reduce::simd_alg(std::cbegin(data), std::cend(data), Value{1}, isa);
+
+        ASSERT_NEAR(res1, res2, (abs_sum + 1) * 16 * std::numeric_limits<Value>::epsilon());
+    }
+}
+
+TEST(ReduceSimd, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_simd_reduce<float>(isa);
+        check_simd_reduce<double>(isa);
+    }
+}
+
+// narrow storage filled from float/int values, the reference sums the stored values exactly
+template<typename Storage, typename Acc>
+auto check_mixed_reduce(simd::Isa isa) -> void {
+    for (std::size_t size : {0, 1, 7, 15, 63, 64, 65, 127, 129, 100'003}) {
+        std::vector<Storage> data(size);
+        if constexpr (std::integral<Storage>) {
+            std::vector<int> values(size);
+            utils::fill_rnd_range(std::begin(values), std::end(values),
+                                  int{std::numeric_limits<Storage>::min()}, int{std::numeric_limits<Storage>::max()});
+            std::transform(std::cbegin(values), std::cend(values), std::begin(data),
+                           [](int v) { return static_cast<Storage>(v); });
+
+            const auto expected = std::accumulate(std::cbegin(data), std::cend(data), std::int64_t{1});
+            ASSERT_EQ(reduce::mixed_alg(std::cbegin(data), std::cend(data), Acc{1}, isa), expected);
+        } else {
+            std::vector<float> values(size);
+            utils::fill_rnd_range(std::begin(values), std::end(values), -3.0f, 3.0f);
+            std::transform(std::cbegin(values), std::cend(values), std::begin(data),
+                           [](float v) { return static_cast<Storage>(v); });
+
+            long double expected = 1, abs_sum = 0;
+            for (const auto v : data) {
+                expected += static_cast<long double>(v);
+                abs_sum += std::abs(static_cast<long double>(v));
+            }
+            const auto res = reduce::mixed_alg(std::cbegin(data), std::cend(data), Acc{1}, isa);
+            ASSERT_NEAR(res, expected, (abs_sum + 1) * 16 * std::numeric_limits<Acc>::epsilon());
+        }
+    }
+}
+
+TEST(ReduceMixed, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_mixed_reduce<simd::float16, float>(isa);
+        check_mixed_reduce<simd::bfloat16, float>(isa);
+        check_mixed_reduce<simd::float16, double>(isa);
+        check_mixed_reduce<simd::bfloat16, double>(isa);
+        check_mixed_reduce<float, double>(isa);
+        check_mixed_reduce<std::int8_t, std::int32_t>(isa);
+        check_mixed_reduce<std::int8_t, std::int64_t>(isa);
+        check_mixed_reduce<std::int16_t, std::int32_t>(isa);
+        check_mixed_reduce<std::int16_t, std::int64_t>(isa);
+        check_mixed_reduce<std::int32_t, std::int64_t>(isa);
+    }
+}
+
+// int16 values near the top of the range: the sum overflows int16 and int32 but not the int64 accumulator
+TEST(ReduceMixed, OpenMPWideningTest) {
+    constexpr std::size_t size = 1'000'003;
+    std::vector<std::int16_t> data(size, std::numeric_limits<std::int16_t>::max());
+    data[size / 2] = std::numeric_limits<std::int16_t>::min();
+
+    const auto expected = std::accumulate(std::cbegin(data), std::cend(data), std::int64_t{0});
+    ASSERT_GT(expected, std::numeric_limits<std::int32_t>::max());
+    ASSERT_EQ(reduce::mixed_openmp_alg(std::cbegin(data), std::cend(data), std::int64_t{0}), expected);
+
+    // float storage into a double accumulator, a float accumulator loses 1 in 2^24 per add
+    std::vector<float> floats(size, 0.1f);
+    const auto sum = reduce::mixed_openmp_alg(std::cbegin(floats), std::cend(floats), 0.0);
+    ASSERT_NEAR(sum, static_cast<double>(0.1f) * size, 1e-12 * size);
+}
+
+TEST(ReduceDeterministic, OpenMPBitwiseEqualAcrossThreadCountsTest) {
+    constexpr std::size_t size = 1'000'003;
+    std::vector<double> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -1e6, 1e6);
+
+    const auto expected = std::bit_cast<std::uint64_t>(reduce::deterministic_alg(std::cbegin(data), std::cend(data), 0.5));
+
+    const auto max_threads = std::max(omp_get_max_threads(), 8);
+    for (int num_threads = 1; num_threads <= max_threads; ++num_threads) {
+        omp_set_num_threads(num_threads);
+        const auto res = reduce::deterministic_openmp_alg(std::cbegin(data), std::cend(data), 0.5);
+        ASSERT_EQ(std::bit_cast<std::uint64_t>(res), expected) << "threads: " << num_threads;
+    }
+}
+
+TEST(ReduceDeterministic, PoolBitwiseEqualAcrossPoolSizesTest) {
+    constexpr std::size_t size = 1'000'003;
+    std::vector<float> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -1e3f, 1e3f);
+
+    const auto expected = std::bit_cast<std::uint32_t>(reduce::deterministic_alg(std::cbegin(data), std::cend(data), 0.0f));
+
+    for (std::size_t num_workers = 1; num_workers <= 8; ++num_workers) {
+        thread_pool::ThreadPool pool(num_workers);
+        const auto res = reduce::deterministic_pool_alg(std::cbegin(data), std::cend(data), 0.0f, pool);
+        ASSERT_EQ(std::bit_cast<std::uint32_t>(res), expected) << "workers: " << num_workers;
+    }
+}
+
+TEST(ReduceDeterministic, NumericTest) {
+    for (std::size_t size : {0, 1, 7, 4'096, 4'097, 100'000}) {
+        std::vector<int> data(size);
+        utils::fill_rnd_range(std::begin(data), std::end(data), -3, 3);
+
+        const auto res1 = std::accumulate(std::cbegin(data), std::cend(data), 0);
+        const auto res2 = reduce::deterministic_openmp_alg(std::cbegin(data), std::cend(data), 0);
+        const auto res3 = reduce::deterministic_pool_alg(std::cbegin(data), std::cend(data), 0);
+
+        ASSERT_EQ(res1, res2);
+        ASSERT_EQ(res1, res3);
+    }
+}
+
+template<typename Value>
+auto check_stats(const std::vector<Value> &data, const reduce::Stats<Value> &res) -> void {
+    ASSERT_EQ(res.count, data.size());
+    if (data.empty()) {
+        return;
+    }
+
+    const auto [min_it, max_it] = std::minmax_element(std::cbegin(data), std::cend(data));
+    // minmax_element reports the last maximum, stats the first one like max_element
+    const auto first_max_it = std::max_element(std::cbegin(data), std::cend(data));
+    ASSERT_EQ(res.min, *min_it);
+    ASSERT_EQ(res.max, *max_it);
+    ASSERT_EQ(res.argmin, static_cast<std::size_t>(min_it - std::cbegin(data)));
+    ASSERT_EQ(res.argmax, static_cast<std::size_t>(first_max_it - std::cbegin(data)));
+
+    long double sum = 0;
+    for (const auto v : data) {
+        sum += v;
+    }
+    const auto mean = sum / data.size();
+    long double m2 = 0;
+    for (const auto v : data) {
+        m2 += (v - mean) * (v - mean);
+    }
+
+    ASSERT_NEAR(static_cast<long double>(res.sum), sum, 1e-9 * (std::abs(sum) + data.size()));
+    ASSERT_NEAR(res.mean, mean, 1e-9 * (std::abs(mean) + 1));
+    ASSERT_NEAR(res.m2, m2, 1e-9 * (m2 + 1));
+    ASSERT_NEAR(res.variance(), m2 / data.size(), 1e-9 * (m2 / data.size() + 1));
+}
+
+template<typename Value>
+auto stats_data(std::size_t size) -> std::vector<Value> {
+    // integral values keep the sums exact and produce plenty of ties for argmin/argmax
+    std::vector<Value> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), Value{-1'000}, Value{1'000});
+    for (auto &v : data) {
+        v = static_cast<Value>(std::round(v));
+    }
+    return data;
+}
+
+TEST(ReduceStats, SerialTest) {
+    for (std::size_t size : {0, 1, 7, 2'048, 2'049, 100'003}) {
+        const auto ints = stats_data<int>(size);
+        check_stats(ints, reduce::stats(std::cbegin(ints), std::cend(ints)));
+
+        const auto doubles = stats_data<double>(size);
+        check_stats(doubles, reduce::stats(std::cbegin(doubles), std::cend(doubles)));
+    }
+}
+
+TEST(ReduceStats, SimdTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        for (std::size_t size : {0, 1, 7, 63, 2'048, 2'049, 100'003}) {
+            const auto doubles = stats_data<double>(size);
+            check_stats(doubles, reduce::simd_stats(std::cbegin(doubles), std::cend(doubles), isa));
+        }
+    }
+}
+
+TEST(ReduceStats, SimdFloatTest) {
+    constexpr std::size_t size = 100'003;
+    std::vector<float> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), -3.0f, 3.0f);
+
+    const auto res1 = reduce::stats(std::cbegin(data), std::cend(data));
+    const auto res2 = reduce::simd_stats(std::cbegin(data), std::cend(data));
+
+    ASSERT_EQ(res1.min, res2.min);
+    ASSERT_EQ(res1.max, res2.max);
+    ASSERT_EQ(res1.argmin, res2.argmin);
+    ASSERT_EQ(res1.argmax, res2.argmax);
+    ASSERT_NEAR(res1.mean, res2.mean, 1e-4);
+    ASSERT_NEAR(res1.variance(), res2.variance(), 1e-4);
+}
+
+TEST(ReduceStats, ParallelTest) {
+    for (std::size_t size : {0, 1, 7, 2'049, 1'000'003}) {
+        const auto ints = stats_data<int>(size);
+        const auto doubles = stats_data<double>(size);
+
+        check_stats(ints, reduce::openmp_stats(std::cbegin(ints), std::cend(ints)));
+        check_stats(doubles, reduce::openmp_stats(std::cbegin(doubles), std::cend(doubles)));
+
+        for (std::size_t num_workers = 1; num_workers <= 4; ++num_workers) {
+            thread_pool::ThreadPool pool(num_workers);
+            check_stats(ints, reduce::pool_stats(std::cbegin(ints), std::cend(ints), pool));
+            check_stats(doubles, reduce::pool_stats(std::cbegin(doubles), std::cend(doubles), pool));
+        }
+    }
+}
+
+TEST(ReduceStats, SelectedStatsTest) {
+    const auto data = stats_data<double>(10'000);
+
+    const auto res = reduce::simd_stats<reduce::stat::argmax | reduce::stat::variance>(std::cbegin(data), std::cend(data));
+    const auto full = reduce::stats(std::cbegin(data), std::cend(data));
+
+    ASSERT_EQ(res.max, full.max);
+    ASSERT_EQ(res.argmax, full.argmax);
+    ASSERT_NEAR(res.mean, full.mean, 1e-9);
+    ASSERT_NEAR(res.variance(), full.variance(), 1e-6);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,386 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#include "simd.h"
+#include "sort.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+// sizes below the comparison sort cutoff, serial radix and parallel radix
+const std::vector<std::size_t> sizes = {0, 1, 100, 10'000, 300'000};
+
+template<typename Value, typename Sort>
+auto check_radix_sort(Value min_val, Value max_val, Sort sort_func) -> void {
+    for (const auto size : sizes) {
+        std::vector<Value> data(size);
+        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        auto expected = data;
+        std::sort(std::begin(expected), std::end(expected));
+
+        sort_func(std::begin(data), std::end(data));
+        ASSERT_EQ(data, expected) << size;
+    }
+}
+
+template<typename Sort>
+auto check_radix_sort_types(Sort sort_func) -> void {
+    check_radix_sort<int>(-10'000, 10'000, sort_func);
+    check_radix_sort<int>(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), sort_func);
+    check_radix_sort<std::int64_t>(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), sort_func);
+    check_radix_sort<unsigned>(0, std::numeric_limits<unsigned>::max(), sort_func);
+    check_radix_sort<std::uint16_t>(0, 1'000, sort_func);
+    check_radix_sort<float>(-1e6f, 1e6f, sort_func);
+    check_radix_sort<double>(-1e300, 1e300, sort_func);
+}
+
+TEST(RadixSort, NumericTest) {
+    check_radix_sort_types([](auto first, auto last) { sort::radix_alg(first, last); });
+}
+
+TEST(RadixSort, OpenMPNumericTest) {
+    check_radix_sort_types([](auto first, auto last) { sort::radix_openmp_alg(first, last); });
+}
+
+TEST(RadixSort, FloatOrderTest) {
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> expected = {-nan, -inf, -1e300, -1.0, -0.0, 0.0, 1e-310, 1.0, inf, nan};
+
+    std::vector<double> data;
+    for (std::size_t i = 0; i < 100; ++i) {
+        data.insert(std::end(data), std::crbegin(expected), std::crend(expected));
+    }
+    sort::radix_alg(std::begin(data), std::end(data));
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(std::bit_cast<std::uint64_t>(data[i]), std::bit_cast<std::uint64_t>(expected[i / 100])) << i;
+    }
+}
+
+TEST(RadixSort, StableProjTest) {
+    constexpr std::size_t size = 200'000;
+    std::vector<int> keys(size);
+    utils::fill_rnd_range(std::begin(keys), std::end(keys), -50, 50);
+
+    std::vector<std::pair<int, std::size_t>> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = {keys[i], i};
+    }
+    auto expected = data;
+    std::stable_sort(std::begin(expected), std::end(expected), [](const auto &lhs, const auto &rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    // descending by key through the projection, equal keys keep their input order
+    const auto proj = [](const std::pair<int, std::size_t> &p) { return -p.first; };
+    auto serial = data;
+    sort::radix_alg(std::begin(serial), std::end(serial), proj);
+    ASSERT_EQ(serial, expected);
+
+    sort::radix_openmp_alg(std::begin(data), std::end(data), proj);
+    ASSERT_EQ(data, expected);
+}
+
+auto cmp_func(int lhs, int rhs) -> bool {
+    return lhs < rhs;
+}
+
+template<typename Sort>
+auto check_comparison_sort(Sort sort_func) -> void {
+    for (const auto size : sizes) {
+        std::vector<int> ints(size);
+        utils::fill_rnd_range(std::begin(ints), std::end(ints), -100, 100);
+        auto expected_ints = ints;
+        std::sort(std::begin(expected_ints), std::end(expected_ints));
+        sort_func(std::begin(ints), std::end(ints), cmp_func);
+        ASSERT_EQ(ints, expected_ints) << size;
+
+        std::vector<double> doubles(size);
+        utils::fill_rnd_range(std::begin(doubles), std::end(doubles), -1e6, 1e6);
+        auto expected_doubles = doubles;
+        std::sort(std::begin(expected_doubles), std::end(expected_doubles), std::greater());
+        sort_func(std::begin(doubles), std::end(doubles), std::greater());
+        ASSERT_EQ(doubles, expected_doubles) << size;
+
+        std::vector<std::string> strings(size / 10);
+        for (auto &str : strings) {
+            str.resize(utils::gen_rnd_num<std::size_t>(0, 8));
+            utils::fill_rnd_str(std::begin(str), std::end(str));
+        }
+        auto expected_strings = strings;
+        std::sort(std::begin(expected_strings), std::end(expected_strings));
+        sort_func(std::begin(strings), std::end(strings), [](const std::string &lhs, const std::string &rhs) {
+            return lhs < rhs;
+        });
+        ASSERT_EQ(strings, expected_strings) << size;
+    }
+
+    // sorted, reversed and all equal inputs
+    std::vector<int> data(300'000);
+    std::iota(std::begin(data), std::end(data), 0);
+    auto expected = data;
+    sort_func(std::begin(data), std::end(data), std::less());
+    ASSERT_EQ(data, expected);
+    std::reverse(std::begin(data), std::end(data));
+    sort_func(std::begin(data), std::end(data), std::less());
+    ASSERT_EQ(data, expected);
+    std::fill(std::begin(data), std::end(data), 7);
+    sort_func(std::begin(data), std::end(data), std::less());
+    ASSERT_TRUE(std::all_of(std::cbegin(data), std::cend(data), [](int x) { return x == 7; }));
+}
+
+TEST(SampleSort, NumericTest) {
+    // several blocks and buckets per thread whatever the core count, the default pool may have no workers
+    thread_pool::ThreadPool pool(4);
+    check_comparison_sort([&pool](auto first, auto last, auto comp) { sort::pool_sample_sort(first, last, comp, pool); });
+}
+
+TEST(MergeSort, NumericTest) {
+    thread_pool::ThreadPool pool(4);
+    check_comparison_sort([&pool](auto first, auto last, auto comp) { sort::pool_merge_sort(first, last, comp, pool); });
+}
+
+TEST(MergeSort, StableTest) {
+    thread_pool::ThreadPool pool(4);
+    for (const auto size : sizes) {
+        std::vector<std::pair<int, std::size_t>> data(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = {utils::gen_rnd_num(0, 20), i};
+        }
+        const auto by_key = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+        auto expected = data;
+        std::stable_sort(std::begin(expected), std::end(expected), by_key);
+
+        sort::pool_merge_sort(std::begin(data), std::end(data), by_key, pool);
+        ASSERT_EQ(data, expected) << size;
+    }
+}
+
+TEST(PdqSort, NumericTest) {
+    const auto pdq_sort = [](auto first, auto last, auto comp) { sort::pdq_sort(first, last, comp); };
+    const auto branchy = [](auto first, auto last, auto comp) { sort::pdq_branchy_sort(first, last, comp); };
+    const auto branchless = [](auto first, auto last, auto comp) { sort::pdq_branchless_sort(first, last, comp); };
+    check_comparison_sort(pdq_sort);
+    check_comparison_sort(branchy);
+    check_comparison_sort(branchless);
+}
+
+TEST(PdqSort, PatternTest) {
+    constexpr std::size_t size = 100'000;
+    std::vector<std::vector<int>> inputs;
+
+    std::vector<int> organ_pipe(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        organ_pipe[i] = static_cast<int>(std::min(i, size - i));
+    }
+    inputs.push_back(organ_pipe);
+
+    std::vector<int> sawtooth(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        sawtooth[i] = static_cast<int>(i % 1'000);
+    }
+    inputs.push_back(sawtooth);
+
+    std::vector<int> few_unique(size);
+    utils::fill_rnd_range(std::begin(few_unique), std::end(few_unique), 0, 3);
+    inputs.push_back(few_unique);
+
+    std::vector<int> nearly_sorted(size);
+    std::iota(std::begin(nearly_sorted), std::end(nearly_sorted), 0);
+    for (std::size_t i = 0; i < 100; ++i) {
+        std::swap(nearly_sorted[utils::gen_rnd_num<std::size_t>(0, size - 1)],
+                  nearly_sorted[utils::gen_rnd_num<std::size_t>(0, size - 1)]);
+    }
+    inputs.push_back(nearly_sorted);
+
+    for (auto &input : inputs) {
+        auto expected = input;
+        std::sort(std::begin(expected), std::end(expected));
+
+        auto branchy = input;
+        sort::pdq_branchy_sort(std::begin(branchy), std::end(branchy));
+        ASSERT_EQ(branchy, expected);
+
+        sort::pdq_sort(std::begin(input), std::end(input));
+        ASSERT_EQ(input, expected);
+    }
+}
+
+template<typename Value>
+auto check_network_sort(simd::Isa isa) -> void {
+    // every length a single network handles, padded or not, and a few handed to pdq_sort
+    std::vector<std::size_t> lengths(257);
+    std::iota(std::begin(lengths), std::end(lengths), 0);
+    lengths.insert(std::end(lengths), {300, 1'000, 100'000});
+
+    for (const auto size : lengths) {
+        std::vector<Value> data(size);
+        utils::fill_rnd_range(std::begin(data), std::end(data), static_cast<Value>(-1'000), static_cast<Value>(1'000));
+        auto expected = data;
+        std::sort(std::begin(expected), std::end(expected));
+
+        sort::network_sort(std::begin(data), std::end(data), isa);
+        ASSERT_EQ(data, expected) << size;
+    }
+
+    // extreme values next to the padding
+    std::vector<Value> extremes = {std::numeric_limits<Value>::max(), 0, std::numeric_limits<Value>::lowest(), 1};
+    if constexpr (std::numeric_limits<Value>::has_infinity) {
+        extremes.push_back(std::numeric_limits<Value>::infinity());
+        extremes.push_back(-std::numeric_limits<Value>::infinity());
+    }
+    auto expected = extremes;
+    std::sort(std::begin(expected), std::end(expected));
+    sort::network_sort(std::begin(extremes), std::end(extremes), isa);
+    ASSERT_EQ(extremes, expected);
+
+    // -0 == +0, so the sort has to be checked for being a permutation of the bits, not only of the values
+    if constexpr (std::is_floating_point_v<Value>) {
+        const auto negative_zeros = [](const std::vector<Value> &v) {
+            return std::count_if(std::cbegin(v), std::cend(v), [](Value x) { return x == 0 && std::signbit(x); });
+        };
+        for (const auto size : lengths) {
+            std::vector<int> ints(size);
+            utils::fill_rnd_range(std::begin(ints), std::end(ints), -2, 2);
+            std::vector<Value> zeros(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                zeros[i] = ints[i] == 0 && i % 2 ? -Value{0} : static_cast<Value>(ints[i]);
+            }
+            auto expected_zeros = zeros;
+            std::sort(std::begin(expected_zeros), std::end(expected_zeros));
+
+            sort::network_sort(std::begin(zeros), std::end(zeros), isa);
+            ASSERT_EQ(zeros, expected_zeros) << size;
+            ASSERT_EQ(negative_zeros(zeros), negative_zeros(expected_zeros)) << size;
+        }
+    }
+}
+
+TEST(NetworkSort, NumericTest) {
+    for (const auto isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (!simd::is_supported(isa)) {
+            continue;
+        }
+        SCOPED_TRACE(simd::isa_name(isa));
+        check_network_sort<std::int32_t>(isa);
+        check_network_sort<std::int64_t>(isa);
+        check_network_sort<float>(isa);
+        check_network_sort<double>(isa);
+    }
+}
+
+TEST(NetworkSort, BaseCaseTest) {
+    const auto pdq_network = [](auto first, auto last, auto comp) { sort::pdq_sort(first, last, comp, sort::NetworkBaseCase{}); };
+    check_comparison_sort(pdq_network);
+
+    // std::less on contiguous arithmetic values is the case that actually reaches the network
+    for (const auto size : sizes) {
+        std::vector<float> data(size);
+        utils::fill_rnd_range(std::begin(data), std::end(data), -1e6f, 1e6f);
+        auto expected = data;
+        std::sort(std::begin(expected), std::end(expected));
+
+        sort::pdq_sort(std::begin(data), std::end(data), std::less(), sort::NetworkBaseCase{});
+        ASSERT_EQ(data, expected) << size;
+    }
+}
+
+TEST(Distributions, ShapeTest) {
+    constexpr std::size_t size = 100'000;
+    std::set<std::string> names;
+
+    for (const auto dist : utils::distributions) {
+        SCOPED_TRACE(utils::distribution_name(dist));
+        names.insert(utils::distribution_name(dist));
+
+        std::vector<int> data(size), again(size), other_seed(size);
+        utils::fill_dist_range(std::begin(data), std::end(data), dist, -1'000'000, 1'000'000);
+        utils::fill_dist_range(std::begin(again), std::end(again), dist, -1'000'000, 1'000'000);
+        utils::fill_dist_range(std::begin(other_seed), std::end(other_seed), dist, -1'000'000, 1'000'000, 7);
+        ASSERT_EQ(data, again);
+        ASSERT_NE(data, other_seed);
+        ASSERT_TRUE(std::all_of(std::cbegin(data), std::cend(data), [](int x) { return -1'000'000 <= x && x <= 1'000'000; }));
+
+        const std::set<int> unique(std::cbegin(data), std::cend(data));
+        const auto mid = std::cbegin(data) + size / 2;
+        switch (dist) {
+            case utils::Distribution::sorted:
+                ASSERT_TRUE(std::is_sorted(std::cbegin(data), std::cend(data)));
+                break;
+            case utils::Distribution::reversed:
+                ASSERT_TRUE(std::is_sorted(std::cbegin(data), std::cend(data), std::greater()));
+                break;
+            case utils::Distribution::nearly_sorted:
+            case utils::Distribution::sorted_runs:
+                ASSERT_FALSE(std::is_sorted(std::cbegin(data), std::cend(data)));
+                ASSERT_GT(std::is_sorted_until(std::cbegin(data), std::cend(data)) - std::cbegin(data), 10);
+                break;
+            case utils::Distribution::organ_pipe:
+                ASSERT_TRUE(std::is_sorted(std::cbegin(data), mid));
+                ASSERT_TRUE(std::is_sorted(mid, std::cend(data), std::greater()));
+                break;
+            case utils::Distribution::few_unique:
+                ASSERT_LE(unique.size(), 16);
+                break;
+            case utils::Distribution::zipf:
+                ASSERT_LE(unique.size(), 4096);
+                ASSERT_GT(unique.size(), 16);
+                break;
+            default:
+                ASSERT_GT(unique.size(), size / 2);
+                break;
+        }
+    }
+    ASSERT_EQ(names.size(), utils::distributions.size());
+
+    std::vector<double> empty;
+    utils::fill_dist_range(std::begin(empty), std::end(empty), utils::Distribution::zipf, 0.0, 1.0);
+    ASSERT_TRUE(empty.empty());
+}
+
+TEST(Distributions, SortTest) {
+    constexpr std::size_t size = 200'000;
+    thread_pool::ThreadPool pool(4);
+
+    for (const auto dist : utils::distributions) {
+        SCOPED_TRACE(utils::distribution_name(dist));
+        std::vector<int> input(size);
+        utils::fill_dist_range(std::begin(input), std::end(input), dist, -10'000, 10'000);
+        auto expected = input;
+        std::sort(std::begin(expected), std::end(expected));
+
+        const auto check = [&](auto sort_func) {
+            auto data = input;
+            sort_func(std::begin(data), std::end(data));
+            ASSERT_EQ(data, expected);
+        };
+        check([](auto first, auto last) { sort::radix_alg(first, last); });
+        check([](auto first, auto last) { sort::radix_openmp_alg(first, last); });
+        check([&pool](auto first, auto last) { sort::pool_sample_sort(first, last, std::less(), pool); });
+        check([&pool](auto first, auto last) { sort::pool_merge_sort(first, last, std::less(), pool); });
+        check([](auto first, auto last) { sort::pdq_sort(first, last); });
+        check([](auto first, auto last) { sort::pdq_branchy_sort(first, last); });
+        check([](auto first, auto last) { sort::network_sort(first, last); });
+    }
+}
+
+int main(int argc, char **argv) {
+    // per-thread histograms and the cross-thread offset scan of radix_openmp_alg need a team on any machine
+    omp_set_num_threads(std::max(omp_get_max_threads(), 4));
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <functional>
+#include <tuple>
+#include <vector>
 
 #include "zip.h"
 #include "utils.h"
@@ -59,6 +62,76 @@ TEST(ZipOpenMPAlg, NumericTest) {
     ASSERT_TRUE(std::equal(std::cbegin(to1), std::cend(to1), std::cbegin(to2)));
 }
 
+TEST(ZipN, NumericTest) {
+    constexpr std::size_t size = 100'003;
+    std::vector<int> in1(size), in2(size), in3(size), in4(size), expected(size);
+    for (auto *in: {&in1, &in2, &in3, &in4}) {
+        utils::fill_rnd_range(std::begin(*in), std::end(*in), -10, 10);
+    }
+    constexpr auto op = [](int a, int b, int c, int d) { return a * b + c - d; };
+    for (std::size_t i = 0; i < size; ++i) {
+        expected[i] = op(in1[i], in2[i], in3[i], in4[i]);
+    }
+
+    std::vector<int> to1(size), to2(size), to3(size);
+    const auto res_it1 = zip::zip_n(op, std::begin(to1), in1, in2, in3, in4);
+    const auto res_it2 = zip::simd_zip_n(op, std::begin(to2), in1, in2, in3, in4);
+    const auto res_it3 = zip::openmp_zip_n(op, std::begin(to3), in1, in2, in3, in4);
+
+    ASSERT_EQ(res_it1, std::cend(to1));
+    ASSERT_EQ(res_it2, std::cend(to2));
+    ASSERT_EQ(res_it3, std::cend(to3));
+    ASSERT_EQ(to1, expected);
+    ASSERT_EQ(to2, expected);
+    ASSERT_EQ(to3, expected);
+}
+
+// a tuple result is scattered into one destination per component
+TEST(ZipN, TupleOutputTest) {
+    constexpr std::size_t size = 10'000;
+    std::vector<double> in1(size), in2(size), in3(size);
+    for (auto *in: {&in1, &in2, &in3}) {
+        utils::fill_rnd_range(std::begin(*in), std::end(*in), -10.0, 10.0);
+    }
+    constexpr auto op = [](double a, double b, double c) { return std::tuple(a + b + c, a * b * c, a < b); };
+
+    const auto check = [&](auto zip_n) {
+        std::vector<double> sums(size), products(size);
+        std::vector<char> less(size);
+        const auto [sum_it, product_it, less_it] = zip_n(
+            op, std::tuple(std::begin(sums), std::begin(products), std::begin(less)), in1, in2, in3
+        );
+
+        ASSERT_EQ(sum_it, std::cend(sums));
+        ASSERT_EQ(product_it, std::cend(products));
+        ASSERT_EQ(less_it, std::cend(less));
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto [sum, product, is_less] = op(in1[i], in2[i], in3[i]);
+            ASSERT_EQ(sums[i], sum);
+            ASSERT_EQ(products[i], product);
+            ASSERT_EQ(static_cast<bool>(less[i]), is_less);
+        }
+    };
+
+    check([](auto &&... args) { return zip::zip_n(args...); });
+    check([](auto &&... args) { return zip::simd_zip_n(args...); });
+    check([](auto &&... args) { return zip::openmp_zip_n(args...); });
+}
+
+// the common length of the inputs is processed, single input is a plain map
+TEST(ZipN, SizeTest) {
+    const std::vector<int> in1{1, 2, 3, 4, 5}, in2{10, 20, 30};
+    std::vector<int> to(5, 0);
+
+    const auto res_it = zip::zip_n(std::plus(), std::begin(to), in1, in2);
+    ASSERT_EQ(res_it, std::begin(to) + 3);
+    ASSERT_EQ(to, (std::vector<int>{11, 22, 33, 0, 0}));
+
+    const auto res_it2 = zip::simd_zip_n([](int x) { return -x; }, std::begin(to), in1);
+    ASSERT_EQ(res_it2, std::end(to));
+    ASSERT_EQ(to, (std::vector<int>{-1, -2, -3, -4, -5}));
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
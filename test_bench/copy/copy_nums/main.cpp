@@ -1,5 +1,10 @@
 #include <benchmark/benchmark.h>
 #include <execution>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
 
 #include "utils.h"
 #include "copy.h"
@@ -38,6 +43,7 @@ static auto gb_loop_copy_alg(benchmark::State &state) -> void {
         benchmark::DoNotOptimize(res_it);
         benchmark::ClobberMemory();
     }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(value_type)));
 }
 
 static auto gb_openmp_copy_alg(benchmark::State &state) -> void {
@@ -53,6 +59,21 @@ static auto gb_openmp_copy_alg(benchmark::State &state) -> void {
     }
 }
 
+static auto gb_openmp_memcpy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::openmp_memcpy_alg(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(value_type)));
+    state.counters["parallel_threshold"] = static_cast<double>(copy::parallel_copy_threshold());
+}
+
 static auto gb_std_copy_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type src(size), dst(size);
@@ -116,6 +137,7 @@ static auto gb_memcpy_alg(benchmark::State &state) -> void {
         benchmark::DoNotOptimize(res_ptr);
         benchmark::ClobberMemory();
     }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(value_type)));
 }
 
 static auto gb_std_ranges_copy_alg(benchmark::State &state) -> void {
@@ -131,6 +153,66 @@ static auto gb_std_ranges_copy_alg(benchmark::State &state) -> void {
     }
 }
 
+static auto gb_stream_copy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::stream_alg(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(value_type)));
+}
+
+// Cost of a copy on whoever runs next: every iteration does a copy (untimed) and then sums a working set that
+// was cache-resident before the copy. A cache-polluting copy leaves the sum to refetch it from memory
+
+static auto hot_set_size() -> std::size_t {
+    constexpr std::size_t min_bytes = 256 * 1'024, max_bytes = 8 * 1'024 * 1'024;
+    return std::clamp(copy::llc_size() / 4, min_bytes, max_bytes) / sizeof(value_type);
+}
+
+template<typename CopyFunc>
+static auto run_followup_bench(benchmark::State &state, CopyFunc copy_func) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size), hot(hot_set_size());
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+    utils::fill_rnd_range(std::begin(hot), std::end(hot), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(std::reduce(std::cbegin(hot), std::cend(hot), std::int64_t{0}));
+        copy_func(src, dst);
+        benchmark::ClobberMemory();
+
+        const auto t_start = std::chrono::steady_clock::now();
+        auto res = std::reduce(std::cbegin(hot), std::cend(hot), std::int64_t{0});
+        benchmark::DoNotOptimize(res);
+        const auto t_finish = std::chrono::steady_clock::now();
+
+        state.SetIterationTime(std::chrono::duration<double>(t_finish - t_start).count());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(hot.size() * sizeof(value_type)));
+}
+
+static auto gb_followup_no_copy_alg(benchmark::State &state) -> void {
+    run_followup_bench(state, [](const container_type &, container_type &) {});
+}
+
+static auto gb_followup_memcpy_alg(benchmark::State &state) -> void {
+    run_followup_bench(state, [](const container_type &src, container_type &dst) {
+        std::memcpy(std::data(dst), std::data(src), std::size(src) * sizeof(value_type));
+    });
+}
+
+static auto gb_followup_stream_copy_alg(benchmark::State &state) -> void {
+    run_followup_bench(state, [](const container_type &src, container_type &dst) {
+        copy::stream_alg(std::cbegin(src), std::cend(src), std::begin(dst));
+    });
+}
+
 constexpr double min_wu_t = 1.0;
 
 BENCHMARK(gb_naive_loop_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
@@ -138,6 +220,7 @@ BENCHMARK(gb_naive_loop_copy_alg)->DenseRange(start, finish, step)->Unit(time_un
 BENCHMARK(gb_loop_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_openmp_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_openmp_memcpy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_std_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 BENCHMARK(gb_std_copy_par_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
@@ -145,6 +228,11 @@ BENCHMARK(gb_std_copy_unseq_alg)->DenseRange(start, finish, step)->Unit(time_uni
 BENCHMARK(gb_std_copy_par_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_memcpy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_stream_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_followup_no_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t)->UseManualTime();
+BENCHMARK(gb_followup_memcpy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t)->UseManualTime();
+BENCHMARK(gb_followup_stream_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t)->UseManualTime();
 
 BENCHMARK(gb_std_ranges_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+#include "copy.h"
+
+// Filling storage with heap-owning elements: copy-assign into constructed elements against constructing
+// into raw storage by copy, by move and by relocation. Every variant does size constructions (or assignments)
+// and size destructions per iteration, the moving ones bounce the elements between two raw buffers
+
+constexpr std::size_t str_size = 100;
+constexpr std::size_t vec_size = 16;
+
+constexpr std::size_t start = 100'000, finish = 1'000'000, step = 100'000;
+
+constexpr auto time_unit = benchmark::kMicrosecond;
+
+template<typename Value>
+static auto make_value() -> Value {
+    if constexpr (std::is_same_v<Value, std::string>) {
+        std::string s(str_size, char{});
+        utils::fill_rnd_str(std::begin(s), std::end(s));
+        return s;
+    } else {
+        std::vector<int> v(vec_size);
+        utils::fill_rnd_range(std::begin(v), std::end(v), -10'000, 10'000);
+        return v;
+    }
+}
+
+template<typename Value>
+static auto make_values(std::size_t size) -> std::vector<Value> {
+    std::vector<Value> res(size);
+    for (auto &v : res) {
+        v = make_value<Value>();
+    }
+    return res;
+}
+
+// raw storage for size elements, the benchmark manages the lifetimes of the objects in it
+template<typename Value>
+class RawBuffer {
+public:
+    explicit RawBuffer(std::size_t size) : size_(size), data_(alloc_.allocate(size)) {}
+
+    RawBuffer(const RawBuffer &) = delete;
+
+    auto operator=(const RawBuffer &) -> RawBuffer & = delete;
+
+    ~RawBuffer() {
+        alloc_.deallocate(data_, size_);
+    }
+
+    [[nodiscard]] auto begin() const -> Value * {
+        return data_;
+    }
+
+    [[nodiscard]] auto end() const -> Value * {
+        return data_ + size_;
+    }
+
+private:
+    std::allocator<Value> alloc_;
+    std::size_t size_;
+    Value *data_;
+};
+
+template<typename Value>
+static auto gb_copy_assign_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto src = make_values<Value>(size);
+    auto dst = make_values<Value>(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::loop_alg(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Value>
+static auto gb_uninitialized_copy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto src = make_values<Value>(size);
+    RawBuffer<Value> dst(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::uninitialized_copy_alg(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+
+        std::destroy(std::begin(dst), std::end(dst));
+    }
+}
+
+template<typename Value>
+static auto gb_openmp_uninitialized_copy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto src = make_values<Value>(size);
+    RawBuffer<Value> dst(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::openmp_uninitialized_copy_alg(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+
+        std::destroy(std::begin(dst), std::end(dst));
+    }
+}
+
+template<typename Value>
+static auto gb_uninitialized_move_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto values = make_values<Value>(size);
+    RawBuffer<Value> buf1(size), buf2(size);
+    auto *from = &buf1, *to = &buf2;
+    copy::uninitialized_copy_alg(std::cbegin(values), std::cend(values), std::begin(*from));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::uninitialized_move_alg(std::begin(*from), std::end(*from), std::begin(*to));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+
+        std::destroy(std::begin(*from), std::end(*from));
+        std::swap(from, to);
+    }
+    std::destroy(std::begin(*from), std::end(*from));
+}
+
+template<typename Value>
+static auto gb_relocate_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto values = make_values<Value>(size);
+    RawBuffer<Value> buf1(size), buf2(size);
+    auto *from = &buf1, *to = &buf2;
+    copy::uninitialized_copy_alg(std::cbegin(values), std::cend(values), std::begin(*from));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::relocate_alg(std::begin(*from), std::end(*from), std::begin(*to));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+
+        std::swap(from, to);
+    }
+    std::destroy(std::begin(*from), std::end(*from));
+}
+
+template<typename Value>
+static auto gb_openmp_relocate_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto values = make_values<Value>(size);
+    RawBuffer<Value> buf1(size), buf2(size);
+    auto *from = &buf1, *to = &buf2;
+    copy::uninitialized_copy_alg(std::cbegin(values), std::cend(values), std::begin(*from));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::openmp_relocate_alg(std::begin(*from), std::end(*from), std::begin(*to));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+
+        std::swap(from, to);
+    }
+    std::destroy(std::begin(*from), std::end(*from));
+}
+
+constexpr double min_wu_t = 1.0;
+
+BENCHMARK_TEMPLATE(gb_copy_assign_alg, std::string)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_uninitialized_copy_alg, std::string)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_openmp_uninitialized_copy_alg, std::string)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_uninitialized_move_alg, std::string)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_relocate_alg, std::string)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_openmp_relocate_alg, std::string)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_copy_assign_alg, std::vector<int>)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_uninitialized_copy_alg, std::vector<int>)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_openmp_uninitialized_copy_alg, std::vector<int>)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_uninitialized_move_alg, std::vector<int>)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_relocate_alg, std::vector<int>)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_openmp_relocate_alg, std::vector<int>)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_MAIN();
@@ -1,8 +1,15 @@
 #include <benchmark/benchmark.h>
 #include <execution>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include <omp.h>
 
 #include "utils.h"
 #include "copy.h"
+#include "flat_string_vector.h"
 
 using value_type = std::string;
 using container_type = std::vector<value_type>;
@@ -133,6 +140,125 @@ static auto gb_std_ranges_copy_alg(benchmark::State &state) -> void {
     }
 }
 
+// the same strings in one arena plus an offset table
+
+static auto make_flat_strings(std::size_t size) -> flat_str::FlatStringVector {
+    value_type s(str_size, char{});
+    flat_str::FlatStringVector res;
+    res.reserve(size, size * str_size);
+    for (std::size_t i = 0; i < size; ++i) {
+        utils::fill_rnd_str(s.begin(), s.end());
+        res.push_back(s);
+    }
+    return res;
+}
+
+static auto gb_flat_loop_copy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto src = make_flat_strings(size);
+    auto dst = make_flat_strings(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        copy::flat_loop_alg(src, dst);
+
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_flat_openmp_copy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto src = make_flat_strings(size);
+    auto dst = make_flat_strings(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        copy::flat_openmp_alg(src, dst);
+
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+}
+
+// pmr::string copies constructed into fresh storage, the workers allocate from per-thread resources.
+// The upstream resource counts the allocations that reach the global allocator
+
+using pmr_value_type = std::pmr::string;
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+    [[nodiscard]] auto allocations() const -> std::size_t {
+        return allocations_.load(std::memory_order_relaxed);
+    }
+
+private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    auto do_deallocate(void *p, std::size_t bytes, std::size_t alignment) -> void override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    auto do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool override {
+        return this == &other;
+    }
+
+    std::atomic<std::size_t> allocations_{0};
+};
+
+// every allocation goes straight upstream, like a plain std::string copy hitting malloc
+class UpstreamResource : public std::pmr::memory_resource {
+public:
+    explicit UpstreamResource(std::pmr::memory_resource *upstream) : upstream_(upstream) {}
+
+    auto release() -> void {}
+
+private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override {
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    auto do_deallocate(void *p, std::size_t bytes, std::size_t alignment) -> void override {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    auto do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream_;
+};
+
+template<typename Resource>
+static auto gb_openmp_pmr_copy_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto num_threads = static_cast<std::size_t>(state.range(1));
+    std::vector<pmr_value_type> src(size, pmr_value_type(str_size, char{}));
+    for (auto &s : src) {
+        utils::fill_rnd_str(s.begin(), s.end());
+    }
+
+    std::allocator<pmr_value_type> storage_alloc;
+    const auto dst = storage_alloc.allocate(size);
+    CountingResource counting;
+    copy::ThreadResources<Resource> resources(num_threads, &counting);
+
+    // copy, then drop the copies and recycle the arenas
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = copy::openmp_pmr_alg(std::cbegin(src), std::cend(src), dst, resources);
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+
+        std::destroy_n(dst, size);
+        resources.release();
+    }
+
+    state.counters["allocs_per_iter"] = static_cast<double>(counting.allocations()) / static_cast<double>(state.iterations());
+    storage_alloc.deallocate(dst, size);
+}
+
 constexpr double min_wu_t = 1.0;
 
 BENCHMARK(gb_naive_loop_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
@@ -148,4 +274,16 @@ BENCHMARK(gb_std_copy_par_unseq_alg)->DenseRange(start, finish, step)->Unit(time
 
 BENCHMARK(gb_std_ranges_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK(gb_flat_loop_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_flat_openmp_copy_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+static const auto pmr_args = std::vector<std::vector<std::int64_t>>{
+    benchmark::CreateRange(start, finish, 10),
+    benchmark::CreateDenseRange(1, std::max(omp_get_max_threads(), 2), 1)
+};
+
+BENCHMARK_TEMPLATE(gb_openmp_pmr_copy_alg, UpstreamResource)->ArgsProduct(pmr_args)->Unit(time_unit)->MinWarmUpTime(min_wu_t)->UseRealTime();
+BENCHMARK_TEMPLATE(gb_openmp_pmr_copy_alg, std::pmr::unsynchronized_pool_resource)->ArgsProduct(pmr_args)->Unit(time_unit)->MinWarmUpTime(min_wu_t)->UseRealTime();
+BENCHMARK_TEMPLATE(gb_openmp_pmr_copy_alg, std::pmr::monotonic_buffer_resource)->ArgsProduct(pmr_args)->Unit(time_unit)->MinWarmUpTime(min_wu_t)->UseRealTime();
+
 BENCHMARK_MAIN();
\ No newline at end of file
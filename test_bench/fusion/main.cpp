@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+#include <execution>
+#include <numeric>
+
+#include "utils.h"
+#include "map.h"
+#include "zip.h"
+#include "reduce.h"
+#include "fusion.h"
+
+// sum(g(f(a[i]), b[i])) with cheap f and g, so every stage is bound by memory traffic: the staged calls write
+// and reread two full temporaries, the fused pipeline and std::transform_reduce only stream a and b once
+
+using value_type = double;
+using container_type = std::vector<value_type>;
+
+constexpr value_type max_val = 10'000;
+constexpr value_type min_val = -max_val;
+
+constexpr std::size_t start = 1'000'000, finish = 10'000'000, step = 3'000'000;
+
+constexpr auto time_unit = benchmark::kMicrosecond;
+
+constexpr auto f = [](value_type x) { return 2 * x + 1; };
+constexpr auto g = [](value_type lhs, value_type rhs) { return lhs * rhs; };
+
+// bytes of input every variant has to read
+static auto set_bytes_processed(benchmark::State &state) -> void {
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * static_cast<std::int64_t>(sizeof(value_type)));
+}
+
+static auto gb_staged_loop_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size), tmp1(size), tmp2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        map::loop_alg(std::cbegin(src1), std::cend(src1), std::begin(tmp1), f);
+        zip::loop_alg(std::cbegin(tmp1), std::cend(tmp1), std::cbegin(src2), std::begin(tmp2), g);
+        auto res = reduce::acc_loop_alg(std::cbegin(tmp2), std::cend(tmp2), value_type{});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+static auto gb_staged_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size), tmp1(size), tmp2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        map::openmp_alg(std::cbegin(src1), std::cend(src1), std::begin(tmp1), f);
+        zip::openmp_alg(std::cbegin(tmp1), std::cend(tmp1), std::cbegin(src2), std::begin(tmp2), g);
+        auto res = reduce::acc_openmp_alg(std::cbegin(tmp2), std::cend(tmp2), value_type{});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+static auto gb_std_transform_reduce_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = std::transform_reduce(
+            std::cbegin(src1), std::cend(src1),
+            std::cbegin(src2),
+            value_type{},
+            std::plus(),
+            [](value_type lhs, value_type rhs) { return g(f(lhs), rhs); }
+        );
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+static auto gb_std_transform_reduce_par_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = std::transform_reduce(
+            std::execution::par,
+            std::cbegin(src1), std::cend(src1),
+            std::cbegin(src2),
+            value_type{},
+            std::plus(),
+            [](value_type lhs, value_type rhs) { return g(f(lhs), rhs); }
+        );
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+static auto gb_fused_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = fusion::pipe(src1) | fusion::map(f) | fusion::zip(src2, g) | fusion::reduce(value_type{});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+static auto gb_fused_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = fusion::pipe(src1) | fusion::map(f) | fusion::zip(src2, g) | fusion::openmp_reduce(value_type{});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+static auto gb_fused_pool_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src1(size), src2(size);
+    utils::fill_rnd_range(std::begin(src1), std::end(src1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(src2), std::end(src2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = fusion::pipe(src1) | fusion::map(f) | fusion::zip(src2, g) | fusion::pool_reduce(value_type{});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    set_bytes_processed(state);
+}
+
+constexpr double min_wu_t = 1.0;
+
+BENCHMARK(gb_staged_loop_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_staged_openmp_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_transform_reduce_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_transform_reduce_par_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_fused_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_fused_openmp_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_fused_pool_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_MAIN();
@@ -1,4 +1,6 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <execution>
 
@@ -33,6 +35,36 @@ static auto gb_inner_prod_loop_alg(benchmark::State &state) -> void {
     }
 }
 
+template<typename Value>
+static auto gb_inner_prod_loop_typed_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    std::vector<Value> data1(size), data2(size);
+    utils::fill_rnd_range(std::begin(data1), std::end(data1), Value{0}, Value{1});
+    utils::fill_rnd_range(std::begin(data2), std::end(data2), Value{0}, Value{1});
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = inner_prod::loop_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Value{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Value>
+static auto gb_inner_prod_simd_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    std::vector<Value> data1(size), data2(size);
+    utils::fill_rnd_range(std::begin(data1), std::end(data1), Value{0}, Value{1});
+    utils::fill_rnd_range(std::begin(data2), std::end(data2), Value{0}, Value{1});
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = inner_prod::simd_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Value{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
 static auto gb_inner_prod_openmp_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type data1(size), data2(size);
@@ -51,6 +83,158 @@ static auto gb_inner_prod_openmp_alg(benchmark::State &state) -> void {
     }
 }
 
+// Mixed precision: Storage elements widened to Acc in the kernels. <double, double> is the all-double baseline,
+// bytes_per_second counts the bytes of both stored ranges
+
+template<typename Storage>
+static auto make_storage(std::size_t size) -> std::vector<Storage> {
+    std::vector<Storage> data(size);
+    if constexpr (std::integral<Storage>) {
+        std::vector<int> values(size);
+        utils::fill_rnd_range(std::begin(values), std::end(values), -100, 100);
+        std::transform(std::cbegin(values), std::cend(values), std::begin(data), [](int v) { return static_cast<Storage>(v); });
+    } else {
+        std::vector<float> values(size);
+        utils::fill_rnd_range(std::begin(values), std::end(values), 0.0f, 1.0f);
+        std::transform(std::cbegin(values), std::cend(values), std::begin(data), [](float v) { return static_cast<Storage>(v); });
+    }
+    return data;
+}
+
+template<typename Storage, typename Acc>
+static auto gb_inner_prod_mixed_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto data1 = make_storage<Storage>(size), data2 = make_storage<Storage>(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = inner_prod::mixed_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Acc{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * 2 * static_cast<std::int64_t>(sizeof(Storage)));
+}
+
+template<typename Storage, typename Acc>
+static auto gb_inner_prod_mixed_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto data1 = make_storage<Storage>(size), data2 = make_storage<Storage>(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = inner_prod::mixed_openmp_alg(std::cbegin(data1), std::cend(data1), std::cbegin(data2), Acc{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * 2 * static_cast<std::int64_t>(sizeof(Storage)));
+}
+
+// Many dot products against the same rows: batch_rows rows of dim columns times 1 or 16 queries, as a loop of
+// single dot products per (query, row) pair and as one batched call. items_per_second counts multiply-adds
+
+const std::vector<std::int64_t> batch_dims = {64, 256, 1'024, 4'096};
+const std::vector<std::int64_t> batch_queries = {1, 16};
+constexpr std::size_t batch_rows = 2'048;
+
+template<typename DotFunc>
+static auto run_rows_bench(benchmark::State &state, DotFunc dot_func) -> void {
+    const auto dim = static_cast<std::size_t>(state.range(0));
+    const auto num_queries = static_cast<std::size_t>(state.range(1));
+    container_type rows(batch_rows * dim), queries(num_queries * dim), res(batch_rows * num_queries);
+    utils::fill_rnd_range(std::begin(rows), std::end(rows), min_val, max_val);
+    utils::fill_rnd_range(std::begin(queries), std::end(queries), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::size_t q = 0; q < num_queries; ++q) {
+            const auto query = queries.data() + q * dim;
+            for (std::size_t r = 0; r < batch_rows; ++r) {
+                const auto row = rows.data() + r * dim;
+                res[q * batch_rows + r] = dot_func(row, row + dim, query);
+            }
+        }
+
+        benchmark::DoNotOptimize(res.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_rows * num_queries * dim));
+}
+
+static auto gb_inner_prod_std_rows_alg(benchmark::State &state) -> void {
+    run_rows_bench(state, [](const value_type *first1, const value_type *last1, const value_type *first2) {
+        return std::inner_product(first1, last1, first2, value_type{0});
+    });
+}
+
+static auto gb_inner_prod_simd_rows_alg(benchmark::State &state) -> void {
+    run_rows_bench(state, [](const value_type *first1, const value_type *last1, const value_type *first2) {
+        return inner_prod::simd_alg(first1, last1, first2, value_type{0});
+    });
+}
+
+static auto gb_inner_prod_batched_alg(benchmark::State &state) -> void {
+    const auto dim = static_cast<std::size_t>(state.range(0));
+    const auto num_queries = static_cast<std::size_t>(state.range(1));
+    container_type rows(batch_rows * dim), queries(num_queries * dim), res(batch_rows * num_queries);
+    utils::fill_rnd_range(std::begin(rows), std::end(rows), min_val, max_val);
+    utils::fill_rnd_range(std::begin(queries), std::end(queries), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        inner_prod::batched(std::cbegin(rows), std::cend(rows), std::cbegin(queries), std::cend(queries), dim,
+                            std::begin(res));
+
+        benchmark::DoNotOptimize(res.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_rows * num_queries * dim));
+}
+
+// Chebyshev distance: max of absolute differences, through the generic op overload
+
+constexpr auto max_op = [](value_type lhs, value_type rhs) { return std::max(lhs, rhs); };
+constexpr auto abs_diff = [](value_type lhs, value_type rhs) { return std::abs(lhs - rhs); };
+
+static auto gb_inner_prod_openmp_op_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data1(size), data2(size);
+    utils::fill_rnd_range(std::begin(data1), std::end(data1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(data2), std::end(data2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = inner_prod::openmp_alg(
+            std::cbegin(data1), std::cend(data1),
+            std::cbegin(data2),
+            static_cast<value_type>(0),
+            max_op, abs_diff,
+            static_cast<value_type>(0)
+        );
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_std_tr_par_op_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data1(size), data2(size);
+    utils::fill_rnd_range(std::begin(data1), std::end(data1), min_val, max_val);
+    utils::fill_rnd_range(std::begin(data2), std::end(data2), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = std::transform_reduce(
+            std::execution::par,
+            std::cbegin(data1), std::cend(data1),
+            std::cbegin(data2),
+            static_cast<value_type>(0),
+            max_op, abs_diff
+        );
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
 static auto gb_std_inner_prod_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type data1(size), data2(size);
@@ -148,7 +332,29 @@ constexpr double min_wu_t = 1.0;
 
 BENCHMARK(gb_inner_prod_loop_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK_TEMPLATE(gb_inner_prod_loop_typed_alg, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_simd_alg, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_simd_alg, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_alg, double, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_alg, float, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_alg, simd::float16, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_alg, simd::bfloat16, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_alg, std::int8_t, std::int32_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_alg, std::int16_t, std::int64_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_openmp_alg, double, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_openmp_alg, float, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_openmp_alg, simd::bfloat16, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_inner_prod_mixed_openmp_alg, std::int8_t, std::int32_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_inner_prod_std_rows_alg)->ArgsProduct({batch_dims, batch_queries})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_inner_prod_simd_rows_alg)->ArgsProduct({batch_dims, batch_queries})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_inner_prod_batched_alg)->ArgsProduct({batch_dims, batch_queries})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
 BENCHMARK(gb_inner_prod_openmp_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_inner_prod_openmp_op_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_tr_par_op_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_std_inner_prod_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
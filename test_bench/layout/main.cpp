@@ -0,0 +1,286 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "utils.h"
+#include "map.h"
+#include "zip.h"
+#include "soa_vector.h"
+
+/*
+ *  NOTE:
+ *  the same records stored as an array of structs (AoS), a struct of arrays (SoA) and an array of blocks of
+ *  8 records stored field by field (AoSoA). map, zip and reduce touch one or two of the five fields, so AoS
+ *  drags the other fields through the caches. bytes_per_second counts only the bytes of the touched fields
+ */
+
+struct Record {
+    double x;
+    double y;
+    double z;
+    double w;
+    std::int64_t key;
+};
+
+// field indices of the soa_vector
+enum Field : std::size_t { X, Y, Z, W, KEY };
+
+using SoaRecords = soa::soa_vector<double, double, double, double, std::int64_t>;
+
+// one 64-byte line per field
+constexpr std::size_t block_lanes = 8;
+
+struct RecordBlock {
+    double x[block_lanes];
+    double y[block_lanes];
+    double z[block_lanes];
+    double w[block_lanes];
+    std::int64_t key[block_lanes];
+};
+
+constexpr double max_val = 10'000;
+constexpr double min_val = -max_val;
+constexpr std::int64_t max_key = 1'000'000'000;
+
+// 8K records (320 KiB) stay in L2, 4M records (160 MiB) come from DRAM
+const std::vector<std::int64_t> sizes = {8'192, 65'536, 1'048'576, 4'194'304};
+
+constexpr auto time_unit = benchmark::kMicrosecond;
+
+constexpr auto f = [](double x) { return 2 * x + 1; };
+constexpr auto g = [](double x, double y) { return x * y; };
+
+static auto make_records(std::size_t size) -> std::vector<Record> {
+    std::vector<double> values(size * 4);
+    std::vector<std::int64_t> keys(size);
+    utils::fill_rnd_range(std::begin(values), std::end(values), min_val, max_val);
+    utils::fill_rnd_range(std::begin(keys), std::end(keys), std::int64_t{0}, max_key);
+
+    std::vector<Record> records(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        records[i] = {values[4 * i], values[4 * i + 1], values[4 * i + 2], values[4 * i + 3], keys[i]};
+    }
+    return records;
+}
+
+struct AosLayout {
+    using storage_type = std::vector<Record>;
+
+    static auto make(std::size_t size) -> storage_type {
+        return make_records(size);
+    }
+
+    static auto map(storage_type &data) -> void {
+        for (auto &r: data) {
+            r.y = f(r.x);
+        }
+    }
+
+    static auto zip(storage_type &data) -> void {
+        for (auto &r: data) {
+            r.z = g(r.x, r.y);
+        }
+    }
+
+    static auto reduce(const storage_type &data) -> double {
+        return std::transform_reduce(
+            std::execution::unseq, std::cbegin(data), std::cend(data), 0.0, std::plus(),
+            [](const Record &r) { return r.x; }
+        );
+    }
+
+    static auto sort(storage_type &data) -> void {
+        std::sort(std::begin(data), std::end(data), [](const Record &lhs, const Record &rhs) {
+            return lhs.key < rhs.key;
+        });
+    }
+};
+
+struct SoaLayout {
+    using storage_type = SoaRecords;
+
+    static auto make(std::size_t size) -> storage_type {
+        SoaRecords data;
+        data.reserve(size);
+        for (const auto &r: make_records(size)) {
+            data.push_back(r.x, r.y, r.z, r.w, r.key);
+        }
+        return data;
+    }
+
+    static auto map(storage_type &data) -> void {
+        const auto x = data.field<X>();
+        map::loop_alg(std::cbegin(x), std::cend(x), std::begin(data.field<Y>()), f);
+    }
+
+    static auto zip(storage_type &data) -> void {
+        const auto x = data.field<X>();
+        zip::loop_alg(std::cbegin(x), std::cend(x), std::cbegin(data.field<Y>()), std::begin(data.field<Z>()), g);
+    }
+
+    static auto reduce(const storage_type &data) -> double {
+        const auto x = data.field<X>();
+        return std::reduce(std::execution::unseq, std::cbegin(x), std::cend(x), 0.0);
+    }
+
+    static auto sort(storage_type &data) -> void {
+        data.sort_by<KEY>();
+    }
+};
+
+struct AosoaLayout {
+    using storage_type = std::vector<RecordBlock>;
+
+    static auto make(std::size_t size) -> storage_type {
+        const auto records = make_records(size);
+        storage_type data(size / block_lanes);
+        for (std::size_t i = 0; i < size; ++i) {
+            auto &block = data[i / block_lanes];
+            const auto lane = i % block_lanes;
+            block.x[lane] = records[i].x;
+            block.y[lane] = records[i].y;
+            block.z[lane] = records[i].z;
+            block.w[lane] = records[i].w;
+            block.key[lane] = records[i].key;
+        }
+        return data;
+    }
+
+    static auto map(storage_type &data) -> void {
+        for (auto &block: data) {
+            for (std::size_t lane = 0; lane < block_lanes; ++lane) {
+                block.y[lane] = f(block.x[lane]);
+            }
+        }
+    }
+
+    static auto zip(storage_type &data) -> void {
+        for (auto &block: data) {
+            for (std::size_t lane = 0; lane < block_lanes; ++lane) {
+                block.z[lane] = g(block.x[lane], block.y[lane]);
+            }
+        }
+    }
+
+    static auto reduce(const storage_type &data) -> double {
+        return std::transform_reduce(
+            std::execution::unseq, std::cbegin(data), std::cend(data), 0.0, std::plus(),
+            [](const RecordBlock &block) {
+                double sum = 0;
+                for (std::size_t lane = 0; lane < block_lanes; ++lane) {
+                    sum += block.x[lane];
+                }
+                return sum;
+            }
+        );
+    }
+
+    // sort (key, index) pairs, then gather the records into fresh blocks
+    static auto sort(storage_type &data) -> void {
+        const auto size = data.size() * block_lanes;
+        std::vector<std::pair<std::int64_t, std::size_t>> order(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            order[i] = {data[i / block_lanes].key[i % block_lanes], i};
+        }
+        std::sort(std::begin(order), std::end(order));
+
+        storage_type sorted(data.size());
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto &from = data[order[i].second / block_lanes];
+            const auto from_lane = order[i].second % block_lanes;
+            auto &to = sorted[i / block_lanes];
+            const auto to_lane = i % block_lanes;
+            to.x[to_lane] = from.x[from_lane];
+            to.y[to_lane] = from.y[from_lane];
+            to.z[to_lane] = from.z[from_lane];
+            to.w[to_lane] = from.w[from_lane];
+            to.key[to_lane] = from.key[from_lane];
+        }
+        data = std::move(sorted);
+    }
+};
+
+template<typename Layout>
+static auto gb_layout_map(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    auto data = Layout::make(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        Layout::map(data);
+
+        benchmark::DoNotOptimize(data);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * 2 * static_cast<std::int64_t>(sizeof(double)));
+}
+
+template<typename Layout>
+static auto gb_layout_zip(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    auto data = Layout::make(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        Layout::zip(data);
+
+        benchmark::DoNotOptimize(data);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * 3 * static_cast<std::int64_t>(sizeof(double)));
+}
+
+template<typename Layout>
+static auto gb_layout_reduce(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto data = Layout::make(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = Layout::reduce(data);
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(double)));
+}
+
+// sorting moves every field, so all of the record counts here
+template<typename Layout>
+static auto gb_layout_sort(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto pristine = Layout::make(size);
+    auto data = pristine;
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        data = pristine;
+        state.ResumeTiming();
+
+        Layout::sort(data);
+
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(Record)));
+}
+
+constexpr double min_wu_t = 1.0;
+
+BENCHMARK_TEMPLATE(gb_layout_map, AosLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_map, SoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_map, AosoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_layout_zip, AosLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_zip, SoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_zip, AosoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_layout_reduce, AosLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_reduce, SoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_reduce, AosoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_layout_sort, AosLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_sort, SoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_layout_sort, AosoaLayout)->ArgsProduct({sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_MAIN();
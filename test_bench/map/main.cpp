@@ -1,8 +1,13 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <execution>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "utils.h"
 #include "map.h"
+#include "simd.h"
 
 using value_type = double;
 using container_type = std::vector<value_type>;
@@ -132,6 +137,133 @@ static auto gb_ranges_transform_alg(benchmark::State &state) -> void {
     }
 }
 
+// the utils::funcs::unary_func workload, scalar libm calls against the vectorized simd_math rewrite
+
+// legendre(3, x) > 0 and cosh(exp(x)) finite
+constexpr value_type func_min_val = 0.8, func_max_val = 3.0;
+
+static auto gb_map_loop_unary_func_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), func_min_val, func_max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = map::loop_alg(
+            std::cbegin(src), std::cend(src),
+            std::begin(dst),
+            utils::funcs::unary_func<value_type>
+        );
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static auto gb_map_openmp_unary_func_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), func_min_val, func_max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = map::openmp_alg(
+            std::cbegin(src), std::cend(src),
+            std::begin(dst),
+            utils::funcs::unary_func<value_type>
+        );
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<simd::Isa isa>
+static auto gb_map_simd_unary_func_alg(benchmark::State &state) -> void {
+    if (!simd::is_supported(isa)) {
+        state.SkipWithError("instruction set is not supported");
+        return;
+    }
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), func_min_val, func_max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = map::simd_alg(
+            std::cbegin(src), std::cend(src),
+            std::begin(dst),
+            [](value_type x) { return utils::funcs::unary_func_simd(x); },
+            isa
+        );
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// map::openmp_alg under each fixed schedule against the adaptive one. Workloads of very different cost:
+// newton_sqrt takes ~1000 iterations for negative inputs and a few dozen otherwise, unary_func is heavy
+// and uniform, and a single multiply-add is cheap enough for the scheduling itself to matter
+
+struct NewtonSqrtWorkload {
+    static constexpr value_type min_val = -10'000, max_val = 10'000;
+    static constexpr auto op = utils::funcs::newton_sqrt<value_type>;
+};
+
+struct UnaryFuncWorkload {
+    static constexpr value_type min_val = func_min_val, max_val = func_max_val;
+    static constexpr auto op = utils::funcs::unary_func<value_type>;
+};
+
+struct TrivialWorkload {
+    static constexpr value_type min_val = -10'000, max_val = 10'000;
+    static constexpr auto op = [](value_type x) { return 2 * x + 1; };
+};
+
+const std::vector<std::pair<map::Schedule, const char *>> fixed_schedules = {
+    {{omp_sched_static, 0}, "static"},
+    {{omp_sched_dynamic, 1}, "dynamic"},
+    {{omp_sched_guided, 0}, "guided"},
+};
+
+template<typename Workload>
+static auto gb_map_openmp_schedule_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto &[schedule, name] = fixed_schedules[state.range(1)];
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), Workload::min_val, Workload::max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = map::openmp_alg(std::cbegin(src), std::cend(src), std::begin(dst), Workload::op, schedule);
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(name);
+}
+
+// the warm-up calibrates, the timed iterations run with the cached choice
+template<typename Workload>
+static auto gb_map_adaptive_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), Workload::min_val, Workload::max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = map::adaptive_openmp_alg(std::cbegin(src), std::cend(src), std::begin(dst), Workload::op);
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+
+    const auto schedule = map::cached_schedule(Workload::op, size).value_or(map::Schedule{});
+    const auto kind = std::find_if(std::cbegin(fixed_schedules), std::cend(fixed_schedules), [&](const auto &s) {
+        return s.first.kind == schedule.kind;
+    });
+    state.SetLabel(std::string(kind->second) + ", chunk " + std::to_string(schedule.chunk));
+}
+
 constexpr double min_wu_t = 1.0;
 
 BENCHMARK(gb_map_loop_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
@@ -145,4 +277,26 @@ BENCHMARK(gb_std_transform_par_unseq_alg)->DenseRange(start, finish, step)->Unit
 
 BENCHMARK(gb_ranges_transform_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK(gb_map_loop_unary_func_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_map_openmp_unary_func_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_simd_unary_func_alg, simd::Isa::scalar)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_simd_unary_func_alg, simd::Isa::sse2)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_simd_unary_func_alg, simd::Isa::avx2)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_simd_unary_func_alg, simd::Isa::avx512)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_map_openmp_schedule_alg, NewtonSqrtWorkload)->ArgsProduct({
+    benchmark::CreateDenseRange(start, finish, step), benchmark::CreateDenseRange(0, 2, 1)
+})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_adaptive_openmp_alg, NewtonSqrtWorkload)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_map_openmp_schedule_alg, UnaryFuncWorkload)->ArgsProduct({
+    benchmark::CreateDenseRange(start, finish, step), benchmark::CreateDenseRange(0, 2, 1)
+})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_adaptive_openmp_alg, UnaryFuncWorkload)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_map_openmp_schedule_alg, TrivialWorkload)->ArgsProduct({
+    benchmark::CreateDenseRange(start, finish, step), benchmark::CreateDenseRange(0, 2, 1)
+})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_map_adaptive_openmp_alg, TrivialWorkload)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
 BENCHMARK_MAIN();
\ No newline at end of file
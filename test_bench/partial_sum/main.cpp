@@ -3,6 +3,7 @@
 #include <execution>
 
 #include "utils.h"
+#include "simd.h"
 #include "partial_sum.h"
 
 using value_type = double;
@@ -28,6 +29,76 @@ static auto gb_naive_p_sum_alg(benchmark::State &state) -> void {
     }
 }
 
+static auto gb_openmp_inc_scan_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::openmp_inclusive_scan(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_openmp_exc_scan_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::openmp_exclusive_scan(std::cbegin(src), std::cend(src), std::begin(dst), value_type{});
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_inc_scan_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::pool_inclusive_scan(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * size * 2 * sizeof(value_type));
+}
+
+static auto gb_pool_exc_scan_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::pool_exclusive_scan(std::cbegin(src), std::cend(src), std::begin(dst), value_type{});
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_decoupled_inc_scan_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::decoupled_inclusive_scan(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+
+    // ideal traffic: one read of src and one write of dst per element
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * size * 2 * sizeof(value_type));
+}
+
 static auto gb_std_p_sum_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type src(size), dst(size);
@@ -65,6 +136,8 @@ static auto gb_std_inc_scan_par_alg(benchmark::State &state) -> void {
         benchmark::DoNotOptimize(res_it);
         benchmark::ClobberMemory();
     }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * size * 2 * sizeof(value_type));
 }
 
 static auto gb_std_inc_scan_unseq_alg(benchmark::State &state) -> void {
@@ -93,10 +166,59 @@ static auto gb_std_inc_scan_par_unseq_alg(benchmark::State &state) -> void {
     }
 }
 
+// SIMD scan group: per element type, the scalar loop against the vectorized kernel at every instruction set
+
+template<typename Value>
+static auto gb_naive_p_sum_typed_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    std::vector<Value> src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), Value{0}, Value{100});
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::naive_partial_sum(std::cbegin(src), std::cend(src), std::begin(dst));
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Value>
+static auto gb_simd_p_sum_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto isa = static_cast<simd::Isa>(state.range(1));
+    if (!simd::is_supported(isa)) {
+        state.SkipWithError("instruction set is not supported");
+        return;
+    }
+    state.SetLabel(simd::isa_name(isa));
+
+    std::vector<Value> src(size), dst(size);
+    utils::fill_rnd_range(std::begin(src), std::end(src), Value{0}, Value{100});
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = par_sum::simd_partial_sum(std::cbegin(src), std::cend(src), std::begin(dst), isa);
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+}
+
 constexpr double min_wu_t = 1.0;
 
+const std::vector<std::int64_t> simd_isas = {
+    static_cast<std::int64_t>(simd::Isa::sse2),
+    static_cast<std::int64_t>(simd::Isa::avx2),
+    static_cast<std::int64_t>(simd::Isa::avx512)
+};
+
 BENCHMARK(gb_naive_p_sum_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK(gb_openmp_inc_scan_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_openmp_exc_scan_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_inc_scan_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_exc_scan_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_decoupled_inc_scan_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
 BENCHMARK(gb_std_p_sum_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_std_inc_scan_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
@@ -104,4 +226,17 @@ BENCHMARK(gb_std_inc_scan_par_alg)->DenseRange(start, finish, step)->Unit(time_u
 BENCHMARK(gb_std_inc_scan_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 BENCHMARK(gb_std_inc_scan_par_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK_TEMPLATE(gb_naive_p_sum_typed_alg, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_simd_p_sum_alg, float)
+    ->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), simd_isas})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_naive_p_sum_typed_alg, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_simd_p_sum_alg, double)
+    ->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), simd_isas})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_naive_p_sum_typed_alg, std::int32_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_simd_p_sum_alg, std::int32_t)
+    ->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), simd_isas})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_naive_p_sum_typed_alg, std::int64_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_simd_p_sum_alg, std::int64_t)
+    ->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), simd_isas})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <numeric>
 #include <execution>
+#include <complex>
+#include <limits>
+#include <cstdint>
 
 #include "utils.h"
 #include "reduce.h"
@@ -28,6 +32,82 @@ static auto gb_acc_loop_alg(benchmark::State &state) -> void {
     }
 }
 
+template<typename Value>
+static auto gb_acc_loop_typed_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    std::vector<Value> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), Value{0}, Value{1});
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::acc_loop_alg(std::cbegin(data), std::cend(data), Value{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Value>
+static auto gb_simd_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    std::vector<Value> data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), Value{0}, Value{1});
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::simd_alg(std::cbegin(data), std::cend(data), Value{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Mixed precision: Storage elements widened to Acc in the kernels. <double, double> is the all-double baseline,
+// bytes_per_second counts the stored bytes
+
+template<typename Storage>
+static auto make_storage(std::size_t size) -> std::vector<Storage> {
+    std::vector<Storage> data(size);
+    if constexpr (std::integral<Storage>) {
+        std::vector<int> values(size);
+        utils::fill_rnd_range(std::begin(values), std::end(values), -100, 100);
+        std::transform(std::cbegin(values), std::cend(values), std::begin(data), [](int v) { return static_cast<Storage>(v); });
+    } else {
+        std::vector<float> values(size);
+        utils::fill_rnd_range(std::begin(values), std::end(values), 0.0f, 1.0f);
+        std::transform(std::cbegin(values), std::cend(values), std::begin(data), [](float v) { return static_cast<Storage>(v); });
+    }
+    return data;
+}
+
+template<typename Storage, typename Acc>
+static auto gb_mixed_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto data = make_storage<Storage>(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::mixed_alg(std::cbegin(data), std::cend(data), Acc{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(Storage)));
+}
+
+template<typename Storage, typename Acc>
+static auto gb_mixed_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto data = make_storage<Storage>(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::mixed_openmp_alg(std::cbegin(data), std::cend(data), Acc{0});
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(Storage)));
+}
+
 static auto gb_acc_openmp_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type data(size);
@@ -41,6 +121,180 @@ static auto gb_acc_openmp_alg(benchmark::State &state) -> void {
     }
 }
 
+static auto gb_deterministic_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::deterministic_openmp_alg(std::cbegin(data), std::cend(data));
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_deterministic_pool_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::deterministic_pool_alg(std::cbegin(data), std::cend(data));
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+// generic op reductions: min, and a product of unit complex numbers (rotations, so it neither overflows nor vanishes)
+
+constexpr auto min_op = [](value_type lhs, value_type rhs) { return std::min(lhs, rhs); };
+constexpr auto max_value = std::numeric_limits<value_type>::max();
+
+using complex_type = std::complex<value_type>;
+
+static auto make_rotations(std::size_t size) -> std::vector<complex_type> {
+    container_type angles(size);
+    utils::fill_rnd_range(std::begin(angles), std::end(angles), -3.0, 3.0);
+    std::vector<complex_type> data(size);
+    std::transform(std::cbegin(angles), std::cend(angles), std::begin(data), [](value_type a) { return std::polar(1.0, a); });
+    return data;
+}
+
+static auto gb_acc_loop_min_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::acc_loop_alg(std::cbegin(data), std::cend(data), max_value, min_op);
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_acc_openmp_min_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::acc_openmp_alg(std::cbegin(data), std::cend(data), max_value, min_op, max_value);
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_std_reduce_par_min_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = std::reduce(std::execution::par, std::cbegin(data), std::cend(data), max_value, min_op);
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_acc_loop_complex_alg(benchmark::State &state) -> void {
+    const auto data = make_rotations(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::acc_loop_alg(std::cbegin(data), std::cend(data), complex_type(1), std::multiplies());
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_acc_openmp_complex_alg(benchmark::State &state) -> void {
+    const auto data = make_rotations(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::acc_openmp_alg(
+            std::cbegin(data), std::cend(data), complex_type(1), std::multiplies(), complex_type(1)
+        );
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_std_reduce_par_complex_alg(benchmark::State &state) -> void {
+    const auto data = make_rotations(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = std::reduce(std::execution::par, std::cbegin(data), std::cend(data), complex_type(1), std::multiplies());
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+// fused statistics (sum, min/max with positions, mean, variance) against a pass per std algorithm
+
+template<typename ExecPolicy>
+static auto separate_stats(ExecPolicy &&policy, const container_type &data) -> reduce::Stats<value_type> {
+    reduce::Stats<value_type> res;
+    res.count = data.size();
+    res.sum = std::reduce(policy, std::cbegin(data), std::cend(data));
+    const auto [min_it, max_it] = std::minmax_element(policy, std::cbegin(data), std::cend(data));
+    res.min = *min_it;
+    res.max = *max_it;
+    res.argmin = static_cast<std::size_t>(min_it - std::cbegin(data));
+    res.argmax = static_cast<std::size_t>(max_it - std::cbegin(data));
+    res.mean = res.sum / static_cast<value_type>(res.count);
+    res.m2 = std::transform_reduce(
+        policy, std::cbegin(data), std::cend(data), value_type{0}, std::plus(),
+        [mean = res.mean](value_type x) { return (x - mean) * (x - mean); }
+    );
+    return res;
+}
+
+template<typename StatsFunc>
+static auto run_stats_bench(benchmark::State &state, StatsFunc stats_func) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = stats_func(data);
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>(sizeof(value_type)));
+}
+
+static auto gb_std_separate_stats_alg(benchmark::State &state) -> void {
+    run_stats_bench(state, [](const container_type &data) { return separate_stats(std::execution::seq, data); });
+}
+
+static auto gb_std_par_separate_stats_alg(benchmark::State &state) -> void {
+    run_stats_bench(state, [](const container_type &data) { return separate_stats(std::execution::par, data); });
+}
+
+static auto gb_stats_alg(benchmark::State &state) -> void {
+    run_stats_bench(state, [](const container_type &data) { return reduce::stats(std::cbegin(data), std::cend(data)); });
+}
+
+static auto gb_simd_stats_alg(benchmark::State &state) -> void {
+    run_stats_bench(state, [](const container_type &data) { return reduce::simd_stats(std::cbegin(data), std::cend(data)); });
+}
+
+static auto gb_openmp_stats_alg(benchmark::State &state) -> void {
+    run_stats_bench(state, [](const container_type &data) { return reduce::openmp_stats(std::cbegin(data), std::cend(data)); });
+}
+
+static auto gb_pool_stats_alg(benchmark::State &state) -> void {
+    run_stats_bench(state, [](const container_type &data) { return reduce::pool_stats(std::cbegin(data), std::cend(data)); });
+}
+
 static auto gb_naive_reduce_thread_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type data(size);
@@ -67,6 +321,36 @@ static auto gb_naive_reduce_async_alg(benchmark::State &state) -> void {
     }
 }
 
+static auto gb_pool_reduce_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::pool_reduce(std::cbegin(data), std::cend(data));
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_reduce_op_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    container_type data(size);
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res = reduce::pool_reduce(
+            std::cbegin(data), std::cend(data), static_cast<value_type>(0), [](value_type lhs, value_type rhs) {
+                return lhs + rhs;
+            }
+        );
+
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+
 static auto gb_std_acc_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
     container_type data(size);
@@ -136,10 +420,44 @@ constexpr double min_wu_t = 1.0;
 
 BENCHMARK(gb_acc_loop_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK_TEMPLATE(gb_acc_loop_typed_alg, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_simd_alg, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_simd_alg, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_mixed_alg, double, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_alg, float, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_alg, simd::float16, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_alg, simd::bfloat16, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_alg, std::int8_t, std::int32_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_alg, std::int16_t, std::int64_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_mixed_openmp_alg, double, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_openmp_alg, float, double)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_openmp_alg, simd::bfloat16, float)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_mixed_openmp_alg, std::int8_t, std::int32_t)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
 BENCHMARK(gb_acc_openmp_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_deterministic_openmp_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_deterministic_pool_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_acc_loop_min_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_acc_openmp_min_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_reduce_par_min_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_acc_loop_complex_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_acc_openmp_complex_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_reduce_par_complex_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_separate_stats_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_par_separate_stats_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_stats_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_simd_stats_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_openmp_stats_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_stats_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_naive_reduce_thread_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 BENCHMARK(gb_naive_reduce_async_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_reduce_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_reduce_op_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK(gb_std_acc_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
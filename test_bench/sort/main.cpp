@@ -1,6 +1,16 @@
 #include <benchmark/benchmark.h>
+#include <cstdint>
 #include <execution>
+#include <thread>
 
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <tbb/global_control.h>
+
+#include "sort.h"
+#include "thread_pool.h"
 #include "utils.h"
 
 using value_type = int;
@@ -20,11 +30,12 @@ constexpr auto qsort_cmp_asc(const void *lhs, const void *rhs) -> Value {
 
 static auto gb_qsort_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::qsort(std::data(data), std::size(data), sizeof(value_type), qsort_cmp_asc);
@@ -35,11 +46,12 @@ static auto gb_qsort_alg(benchmark::State &state) -> void {
 
 static auto gb_std_sort_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::begin(data), std::end(data));
@@ -50,11 +62,12 @@ static auto gb_std_sort_alg(benchmark::State &state) -> void {
 
 static auto gb_std_sort_par_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::execution::par, std::begin(data), std::end(data));
@@ -65,11 +78,12 @@ static auto gb_std_sort_par_alg(benchmark::State &state) -> void {
 
 static auto gb_std_sort_unseq_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::execution::unseq, std::begin(data), std::end(data));
@@ -80,11 +94,12 @@ static auto gb_std_sort_unseq_alg(benchmark::State &state) -> void {
 
 static auto gb_std_sort_par_unseq_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::execution::par_unseq, std::begin(data), std::end(data));
@@ -95,11 +110,12 @@ static auto gb_std_sort_par_unseq_alg(benchmark::State &state) -> void {
 
 static auto gb_std_stable_sort_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::stable_sort(std::begin(data), std::end(data));
@@ -110,11 +126,12 @@ static auto gb_std_stable_sort_alg(benchmark::State &state) -> void {
 
 static auto gb_std_stable_sort_par_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::stable_sort(std::execution::par, std::begin(data), std::end(data));
@@ -125,11 +142,12 @@ static auto gb_std_stable_sort_par_alg(benchmark::State &state) -> void {
 
 static auto gb_std_stable_sort_unseq_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::stable_sort(std::execution::unseq, std::begin(data), std::end(data));
@@ -140,11 +158,12 @@ static auto gb_std_stable_sort_unseq_alg(benchmark::State &state) -> void {
 
 static auto gb_std_stable_sort_par_unseq_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::stable_sort(std::execution::par_unseq, std::begin(data), std::end(data));
@@ -155,11 +174,12 @@ static auto gb_std_stable_sort_par_unseq_alg(benchmark::State &state) -> void {
 
 static auto gb_std_ranges_sort_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::ranges::sort(data);
@@ -170,11 +190,12 @@ static auto gb_std_ranges_sort_alg(benchmark::State &state) -> void {
 
 static auto gb_std_ranges_stable_sort_alg(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::ranges::stable_sort(data);
@@ -183,21 +204,400 @@ static auto gb_std_ranges_stable_sort_alg(benchmark::State &state) -> void {
     }
 }
 
-constexpr double min_wu_t = 1.0;
+static auto gb_radix_sort_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::radix_alg(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_radix_sort_openmp_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::radix_openmp_alg(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_sample_sort_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_sample_sort(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_merge_sort_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_merge_sort(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+// Branch misses of the calling thread in user space, counted through perf_event_open while started.
+// Reads zero where hardware counters are not exposed (perf_event_paranoid, VMs without a PMU)
+class BranchMisses {
+public:
+    BranchMisses() {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    BranchMisses(const BranchMisses &) = delete;
+
+    auto operator=(const BranchMisses &) -> BranchMisses & = delete;
+
+    ~BranchMisses() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    auto start() const -> void {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    auto stop() const -> void {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    [[nodiscard]] auto count() const -> std::uint64_t {
+        std::uint64_t value = 0;
+        if (fd_ < 0 || read(fd_, &value, sizeof(value)) != sizeof(value)) {
+            return 0;
+        }
+        return value;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+// Sorts with the branch misses of the timed part reported per element, branch_misses / elem
+template<typename SortFunc>
+static auto run_branch_misses_bench(benchmark::State &state, SortFunc sort_func) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+    const BranchMisses misses;
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        misses.start();
+        sort_func(std::begin(data), std::end(data));
+        misses.stop();
+
+        benchmark::ClobberMemory();
+    }
+    state.counters["branch_misses/elem"] = benchmark::Counter(
+        static_cast<double>(misses.count()) / static_cast<double>(size), benchmark::Counter::kAvgIterations
+    );
+}
+
+static auto gb_std_sort_branch_misses_alg(benchmark::State &state) -> void {
+    run_branch_misses_bench(state, [](auto first, auto last) { std::sort(first, last); });
+}
+
+static auto gb_pdq_sort_branch_misses_alg(benchmark::State &state) -> void {
+    run_branch_misses_bench(state, [](auto first, auto last) { sort::pdq_sort(first, last); });
+}
+
+static auto gb_pdq_branchy_sort_branch_misses_alg(benchmark::State &state) -> void {
+    run_branch_misses_bench(state, [](auto first, auto last) { sort::pdq_branchy_sort(first, last); });
+}
+
+// Parallel comparison sorts over thread counts, state.range(1) threads: the PSTL sorts with the TBB backend
+// limited through tbb::global_control, the pool sorts on a pool of that many threads (the caller included)
+
+static auto thread_counts() -> std::vector<std::int64_t> {
+    const auto max_threads = static_cast<std::int64_t>(std::max(std::thread::hardware_concurrency(), 2u));
+    std::vector<std::int64_t> counts;
+    for (std::int64_t t = 2; t < max_threads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+template<typename SortFunc>
+static auto run_pstl_threads_bench(benchmark::State &state, SortFunc sort_func) -> void {
+    container_type data(state.range(0));
+    tbb::global_control limit(tbb::global_control::max_allowed_parallelism, static_cast<std::size_t>(state.range(1)));
 
-BENCHMARK(gb_qsort_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        state.ResumeTiming();
+
+        sort_func(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename SortFunc>
+static auto run_pool_threads_bench(benchmark::State &state, SortFunc sort_func) -> void {
+    container_type data(state.range(0));
+    thread_pool::ThreadPool pool(static_cast<std::size_t>(state.range(1)) - 1);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        state.ResumeTiming();
+
+        sort_func(std::begin(data), std::end(data), pool);
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_std_sort_par_threads_alg(benchmark::State &state) -> void {
+    run_pstl_threads_bench(state, [](auto first, auto last) { std::sort(std::execution::par, first, last); });
+}
+
+static auto gb_std_stable_sort_par_threads_alg(benchmark::State &state) -> void {
+    run_pstl_threads_bench(state, [](auto first, auto last) { std::stable_sort(std::execution::par, first, last); });
+}
+
+static auto gb_pool_sample_sort_threads_alg(benchmark::State &state) -> void {
+    run_pool_threads_bench(state, [](auto first, auto last, auto &pool) {
+        sort::pool_sample_sort(first, last, std::less(), pool);
+    });
+}
+
+static auto gb_pool_merge_sort_threads_alg(benchmark::State &state) -> void {
+    run_pool_threads_bench(state, [](auto first, auto last, auto &pool) {
+        sort::pool_merge_sort(first, last, std::less(), pool);
+    });
+}
+
+static auto gb_pdq_network_sort_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pdq_sort(std::begin(data), std::end(data), std::less<>(), sort::NetworkBaseCase{});
+
+        benchmark::ClobberMemory();
+    }
+}
+
+// Many small independent arrays: every iteration sorts batch_arrays arrays of state.range(0) elements. The arrays
+// are copied out of a random pool of batch_pool_elems elements (cycled through) into a scratch array and sorted
+// there, the copy is part of the timing for every algorithm. items_per_second counts sorted arrays
+
+const std::vector<std::int64_t> batch_sizes = {16, 32, 64, 128, 256};
+constexpr std::size_t batch_arrays = 1'000'000;
+constexpr std::size_t batch_pool_elems = 1 << 22;
+
+template<typename Value, typename SortFunc>
+static auto run_batch_bench(benchmark::State &state, SortFunc sort_func) -> void {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    std::vector<Value> pool(batch_pool_elems), scratch(size);
+    utils::fill_rnd_range(std::begin(pool), std::end(pool), static_cast<Value>(-1'000'000), static_cast<Value>(1'000'000));
+    const auto pool_arrays = batch_pool_elems / size;
+
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::size_t a = 0; a < batch_arrays; ++a) {
+            const auto src = pool.data() + a % pool_arrays * size;
+            std::copy(src, src + size, scratch.data());
+            sort_func(std::begin(scratch), std::end(scratch));
+            benchmark::DoNotOptimize(scratch.data());
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_arrays));
+}
 
-BENCHMARK(gb_std_sort_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_sort_par_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_sort_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_sort_par_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+template<typename Value>
+static auto gb_std_sort_batch_alg(benchmark::State &state) -> void {
+    run_batch_bench<Value>(state, [](auto first, auto last) { std::sort(first, last); });
+}
+
+template<typename Value>
+static auto gb_pdq_sort_batch_alg(benchmark::State &state) -> void {
+    run_batch_bench<Value>(state, [](auto first, auto last) { sort::pdq_sort(first, last); });
+}
+
+template<typename Value>
+static auto gb_network_sort_batch_alg(benchmark::State &state) -> void {
+    run_batch_bench<Value>(state, [](auto first, auto last) { sort::network_sort(first, last); });
+}
+
+// Key type and key range sweep: keys in [-range, range] ([0, range] for unsigned keys), range = state.range(1).
+// A narrow range leaves the high digits constant, which lets the radix sorts skip those passes
+
+const std::vector<std::int64_t> key_ranges = {10'000, 1'000'000, 1'000'000'000};
+
+template<typename Value>
+static auto fill_keys(std::vector<Value> &data, std::int64_t range) -> void {
+    const auto max_key = static_cast<Value>(range);
+    const auto min_key = std::is_signed_v<Value> ? static_cast<Value>(-max_key) : Value{0};
+    utils::fill_rnd_range(std::begin(data), std::end(data), min_key, max_key);
+}
+
+template<typename Value>
+static auto gb_std_sort_keys_alg(benchmark::State &state) -> void {
+    std::vector<Value> data(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        fill_keys(data, state.range(1));
+        state.ResumeTiming();
+
+        std::sort(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Value>
+static auto gb_radix_sort_keys_alg(benchmark::State &state) -> void {
+    std::vector<Value> data(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        fill_keys(data, state.range(1));
+        state.ResumeTiming();
+
+        sort::radix_alg(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
 
-BENCHMARK(gb_std_stable_sort_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_stable_sort_par_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_stable_sort_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_stable_sort_par_unseq_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+template<typename Value>
+static auto gb_radix_sort_openmp_keys_alg(benchmark::State &state) -> void {
+    std::vector<Value> data(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        fill_keys(data, state.range(1));
+        state.ResumeTiming();
+
+        sort::radix_openmp_alg(std::begin(data), std::end(data));
+
+        benchmark::ClobberMemory();
+    }
+}
+
+constexpr double min_wu_t = 1.0;
 
-BENCHMARK(gb_std_ranges_sort_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_ranges_stable_sort_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_qsort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_sort_par_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_sort_unseq_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_sort_par_unseq_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_stable_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_stable_sort_par_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_stable_sort_unseq_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_stable_sort_par_unseq_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_ranges_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_ranges_stable_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_radix_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_radix_sort_openmp_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_pool_sample_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_merge_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_sort_branch_misses_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pdq_sort_branch_misses_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pdq_branchy_sort_branch_misses_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_pdq_network_sort_alg)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_std_sort_batch_alg, std::int32_t)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_batch_alg, float)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_batch_alg, std::int64_t)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_batch_alg, double)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_pdq_sort_batch_alg, std::int32_t)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_pdq_sort_batch_alg, float)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_pdq_sort_batch_alg, std::int64_t)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_pdq_sort_batch_alg, double)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_network_sort_batch_alg, std::int32_t)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_network_sort_batch_alg, float)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_network_sort_batch_alg, std::int64_t)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_network_sort_batch_alg, double)->ArgsProduct({batch_sizes})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_std_sort_par_threads_alg)->ArgsProduct({{start, finish}, thread_counts()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_stable_sort_par_threads_alg)->ArgsProduct({{start, finish}, thread_counts()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_sample_sort_threads_alg)->ArgsProduct({{start, finish}, thread_counts()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_merge_sort_threads_alg)->ArgsProduct({{start, finish}, thread_counts()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_std_sort_keys_alg, int)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_keys_alg, std::int64_t)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_keys_alg, unsigned)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_keys_alg, float)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_std_sort_keys_alg, double)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_radix_sort_keys_alg, int)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_keys_alg, std::int64_t)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_keys_alg, unsigned)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_keys_alg, float)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_keys_alg, double)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_radix_sort_openmp_keys_alg, int)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_openmp_keys_alg, std::int64_t)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_openmp_keys_alg, unsigned)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_openmp_keys_alg, float)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_radix_sort_openmp_keys_alg, double)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), key_ranges})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -1,11 +1,15 @@
 #include <benchmark/benchmark.h>
+#include <cstdint>
 
+#include "sort.h"
 #include "utils.h"
 
 /*
  *  NOTE:
  *  comparison of sorting function speed depending on comparator type (func, method, lambda)
  *  GCC vs Clang
+ *  the same comparators through the pool sample sort and merge sort
+ *  every case over the input distributions of utils.h
  */
 
 using value_type = int;
@@ -36,11 +40,12 @@ constexpr auto cmp_closure = []<typename Value>(Value lhs, Value rhs) { return l
 
 static auto gb_std_sort_func_cmp(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::begin(data), std::end(data), cmp_func<value_type>);
@@ -51,11 +56,12 @@ static auto gb_std_sort_func_cmp(benchmark::State &state) -> void {
 
 static auto gb_std_sort_struct_cmp(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::begin(data), std::end(data), Comparator<value_type>{});
@@ -66,11 +72,12 @@ static auto gb_std_sort_struct_cmp(benchmark::State &state) -> void {
 
 static auto gb_std_sort_closure_cmp(benchmark::State &state) -> void {
     const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
     container_type data(size);
 
     for ([[maybe_unused]] auto _ : state) {
         state.PauseTiming();
-        utils::fill_rnd_range(std::begin(data), std::end(data), min_val, max_val);
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
         state.ResumeTiming();
 
         std::sort(std::begin(data), std::end(data), cmp_closure);
@@ -79,10 +86,114 @@ static auto gb_std_sort_closure_cmp(benchmark::State &state) -> void {
     }
 }
 
+static auto gb_pool_sample_sort_func_cmp(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_sample_sort(std::begin(data), std::end(data), cmp_func<value_type>);
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_sample_sort_struct_cmp(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_sample_sort(std::begin(data), std::end(data), Comparator<value_type>{});
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_sample_sort_closure_cmp(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_sample_sort(std::begin(data), std::end(data), cmp_closure);
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_merge_sort_func_cmp(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_merge_sort(std::begin(data), std::end(data), cmp_func<value_type>);
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_merge_sort_struct_cmp(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_merge_sort(std::begin(data), std::end(data), Comparator<value_type>{});
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static auto gb_pool_merge_sort_closure_cmp(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto input = utils::dist_input<container_type>(state, min_val, max_val);
+    container_type data(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        std::copy(std::cbegin(input), std::cend(input), std::begin(data));
+        state.ResumeTiming();
+
+        sort::pool_merge_sort(std::begin(data), std::end(data), cmp_closure);
+
+        benchmark::ClobberMemory();
+    }
+}
+
 constexpr double min_wu_t = 1.0;
 
-BENCHMARK(gb_std_sort_func_cmp)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_sort_struct_cmp)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
-BENCHMARK(gb_std_sort_closure_cmp)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_sort_func_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_sort_struct_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_std_sort_closure_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_pool_sample_sort_func_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_sample_sort_struct_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_sample_sort_closure_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK(gb_pool_merge_sort_func_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_merge_sort_struct_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK(gb_pool_merge_sort_closure_cmp)->ArgsProduct({benchmark::CreateDenseRange(start, finish, step), utils::distribution_args()})->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
+#include <array>
 #include <execution>
+#include <tuple>
 
 #include "utils.h"
 #include "zip.h"
@@ -145,6 +147,79 @@ static auto gb_std_ranges_transform_alg(benchmark::State &state) -> void {
     }
 }
 
+// N-ary zip with a cheap op, so time is set by streaming the inputs: a weighted sum of the N columns
+// into one output, or scattered into two SoA columns (the sum and its square)
+
+constexpr std::size_t n_start = 1'000'000, n_finish = 4'000'000, n_step = 1'000'000;
+
+enum class ZipBackend { serial, simd, openmp };
+
+template<std::size_t N>
+static auto make_columns(std::size_t size) -> std::array<container_type, N> {
+    std::array<container_type, N> columns;
+    for (auto &column: columns) {
+        column.resize(size);
+        utils::fill_rnd_range(std::begin(column), std::end(column), min_val, max_val);
+    }
+    return columns;
+}
+
+template<ZipBackend backend, typename Out, std::size_t N, typename NaryOp>
+static auto run_zip_n(NaryOp op, Out out, const std::array<container_type, N> &columns) -> Out {
+    return std::apply([&](const auto &... ins) {
+        if constexpr (backend == ZipBackend::serial) {
+            return zip::zip_n(op, out, ins...);
+        } else if constexpr (backend == ZipBackend::simd) {
+            return zip::simd_zip_n(op, out, ins...);
+        } else {
+            return zip::openmp_zip_n(op, out, ins...);
+        }
+    }, columns);
+}
+
+constexpr auto weighted_sum = [](auto... xs) {
+    value_type w = 0, res = 0;
+    ((res += ++w * xs), ...);
+    return res;
+};
+
+template<ZipBackend backend, std::size_t N>
+static auto gb_zip_n_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto columns = make_columns<N>(size);
+    container_type dst(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_it = run_zip_n<backend>(weighted_sum, std::begin(dst), columns);
+
+        benchmark::DoNotOptimize(res_it);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>((N + 1) * sizeof(value_type)));
+}
+
+template<ZipBackend backend, std::size_t N>
+static auto gb_zip_n_soa_alg(benchmark::State &state) -> void {
+    const auto size = state.range(0);
+    const auto columns = make_columns<N>(size);
+    container_type dst1(size), dst2(size);
+
+    for ([[maybe_unused]] auto _ : state) {
+        auto res_its = run_zip_n<backend>(
+            [](auto... xs) {
+                const auto sum = weighted_sum(xs...);
+                return std::tuple(sum, sum * sum);
+            },
+            std::tuple(std::begin(dst1), std::begin(dst2)),
+            columns
+        );
+
+        benchmark::DoNotOptimize(res_its);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size * static_cast<std::int64_t>((N + 2) * sizeof(value_type)));
+}
+
 constexpr double min_wu_t = 1.0;
 
 BENCHMARK(gb_zip_loop_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
@@ -158,4 +233,28 @@ BENCHMARK(gb_std_transform_par_unseq_alg)->DenseRange(start, finish, step)->Unit
 
 BENCHMARK(gb_std_ranges_transform_alg)->DenseRange(start, finish, step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
 
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::serial, 2)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::serial, 4)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::serial, 6)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::simd, 2)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::simd, 4)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::simd, 6)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::openmp, 2)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::openmp, 4)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_alg, ZipBackend::openmp, 6)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::serial, 2)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::serial, 4)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::serial, 6)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::simd, 2)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::simd, 4)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::simd, 6)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::openmp, 2)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::openmp, 4)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+BENCHMARK_TEMPLATE(gb_zip_n_soa_alg, ZipBackend::openmp, 6)->DenseRange(n_start, n_finish, n_step)->Unit(time_unit)->MinWarmUpTime(min_wu_t);
+
 BENCHMARK_MAIN();
\ No newline at end of file